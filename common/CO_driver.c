@@ -50,6 +50,13 @@
 #include "CO_Emergency.h"
 #include "can_hw.h"
 
+/* Receive monitors, kept across CAN module reinitialization */
+static struct {
+    void *object;
+    void (*pFunct)(void *object, const CO_CANrxMsg_t *message);
+} rxMonitors[CO_CAN_RX_MONITORS];
+static bool_t rxMonitorsUsed = false;
+
 /******************************************************************************/
 void CO_CANsetConfigurationMode(void *CANbaseAddress)
 {
@@ -102,7 +109,7 @@ CO_ReturnError_t CO_CANmodule_init(
     CANmodule->txArray = txArray;
     CANmodule->txSize = txSize;
     CANmodule->CANnormal = false;
-    CANmodule->useCANrxFilters = (rxSize <= STM32_CAN_MAX_FILTERS ? rxSize : 0);
+    CANmodule->useCANrxFilters = (rxSize <= STM32_CAN_MAX_FILTERS && !rxMonitorsUsed ? rxSize : 0);
     CANmodule->bufferInhibitFlag = false;
     CANmodule->firstCANtxMessage = true;
     CANmodule->CANtxCount = 0U;
@@ -167,6 +174,29 @@ uint16_t CO_CANrxMsg_readIdent(const CO_CANrxMsg_t *rxMsg)
 }
 
 
+/******************************************************************************/
+void CO_CANrxMonitorInit(
+        uint16_t                index,
+        void                   *object,
+        void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message))
+{
+    if (index >= CO_CAN_RX_MONITORS) {
+        return;
+    }
+
+    chSysLock();
+    rxMonitors[index].object = object;
+    rxMonitors[index].pFunct = pFunct;
+    rxMonitorsUsed = false;
+    for (index = 0U; index < CO_CAN_RX_MONITORS; index++) {
+        if (rxMonitors[index].pFunct != NULL) {
+            rxMonitorsUsed = true;
+        }
+    }
+    chSysUnlock();
+}
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_CANrxBufferInit(
         CO_CANmodule_t         *CANmodule,
@@ -369,8 +399,8 @@ void CO_CANrx_cb(CANDriver *canp, uint32_t flags)
     CO_CANrxMsg_t       rcvMsg;             /* Received message */
     uint8_t             index;              /* index of received message */
     uint32_t            rcvMsgIdent;        /* identifier of the received message */
-    CO_CANrx_t          *buffer = NULL;     /* receive message buffer from CO_CANmodule_t object. */
-    bool_t              msgMatched = false;
+    CO_CANrx_t          *buffer;            /* receive message buffer from CO_CANmodule_t object. */
+    bool_t              msgMatched;
     (void)flags;
 
     if (canp == NULL)
@@ -378,32 +408,41 @@ void CO_CANrx_cb(CANDriver *canp, uint32_t flags)
     CANmodule = container_of(canp->config, CO_CANmodule_t, cancfg);
 
     chSysLockFromISR();
-    canTryReceiveI(canp, CAN_ANY_MAILBOX, &rcvMsg.rxFrame);
-    rcvMsgIdent = rcvMsg.SID | (rcvMsg.RTR << 11);
-    if (CANmodule->useCANrxFilters) {
-        /* CAN module filters are used. Message with known 11-bit identifier has */
-        /* been received */
-        index = rcvMsg.FMI;  /* Get index of the received message */
-        if (index < CANmodule->rxSize) {
-            buffer = &CANmodule->rxArray[index];
-            msgMatched = true;
-        }
-    } else {
-        /* CAN module filters are not used, message with any standard 11-bit identifier */
-        /* has been received. Search rxArray form CANmodule for the same CAN-ID. */
-        buffer = &CANmodule->rxArray[0];
-        for (index = CANmodule->rxSize; index > 0U; index--) {
-            if (((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U) {
+    /* Drain the receive FIFOs, their interrupt stays off until they are empty */
+    while (!canTryReceiveI(canp, CAN_ANY_MAILBOX, &rcvMsg.rxFrame)) {
+        buffer = NULL;
+        msgMatched = false;
+        rcvMsgIdent = rcvMsg.SID | (rcvMsg.RTR << 11);
+        if (CANmodule->useCANrxFilters) {
+            /* CAN module filters are used. Message with known 11-bit identifier has */
+            /* been received */
+            index = rcvMsg.FMI;  /* Get index of the received message */
+            if (index < CANmodule->rxSize) {
+                buffer = &CANmodule->rxArray[index];
                 msgMatched = true;
-                break;
             }
-            buffer++;
+        } else {
+            /* CAN module filters are not used, message with any standard 11-bit identifier */
+            /* has been received. Search rxArray form CANmodule for the same CAN-ID. */
+            buffer = &CANmodule->rxArray[0];
+            for (index = CANmodule->rxSize; index > 0U; index--) {
+                if (((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U) {
+                    msgMatched = true;
+                    break;
+                }
+                buffer++;
+            }
         }
-    }
 
-    /* Call specific function, which will process the message */
-    if (msgMatched && (buffer != NULL) && (buffer->pFunct != NULL)) {
-        buffer->pFunct(buffer->object, &rcvMsg);
+        /* Call specific function, which will process the message */
+        if (msgMatched && (buffer != NULL) && (buffer->pFunct != NULL)) {
+            buffer->pFunct(buffer->object, &rcvMsg);
+        }
+        for (index = 0U; index < CO_CAN_RX_MONITORS; index++) {
+            if (rxMonitors[index].pFunct != NULL) {
+                rxMonitors[index].pFunct(rxMonitors[index].object, &rcvMsg);
+            }
+        }
     }
     chEvtBroadcastI(&CANmodule->rx_event);
     chSysUnlockFromISR();
@@ -1,8 +1,337 @@
 #include "ch.h"
 #include "CO_master.h"
 
-int sdo_upload(
-        CO_SDOclient_t *SDOclient,
+#if CO_NO_SDO_CLIENT != 0
+
+#define SDO_NODES               128
+
+typedef struct {
+    CO_SDOclient_t *client;
+    sdo_req_t *req;
+    systime_t prev_time;
+    uint8_t node_id;            /* Server the client is set up for, 0 if none */
+} sdo_slot_t;
+
+static sdo_slot_t slots[CO_NO_SDO_CLIENT];
+/* FIFO of requests not started yet, guarded by sdo_mtx */
+static sdo_req_t *queue;
+static bool running;
+static MUTEX_DECL(sdo_mtx);
+/* Dispatch stamp of the last transfer started per node, for fairness */
+static uint32_t served[SDO_NODES];
+static uint32_t stamp;
+/* Finished requests in completion order, completed by the pool thread outside of sdo_mtx */
+static sdo_req_t *finished;
+static sdo_req_t **finished_tail = &finished;
+
+/* Signalled from the CAN RX interrupt on a server response and on submission */
+static BSEMAPHORE_DECL(sdo_bsem, true);
+
+static void sdo_signal(void)
+{
+    chBSemSignalI(&sdo_bsem);
+}
+
+static void sdo_finish(sdo_req_t *req, CO_SDOclient_return_t status)
+{
+    req->status = status;
+    req->next = NULL;
+    *finished_tail = req;
+    finished_tail = &req->next;
+}
+
+/* Callbacks may resubmit, so this runs with sdo_mtx released */
+static void sdo_complete(void)
+{
+    sdo_req_t *list = finished;
+
+    finished = NULL;
+    finished_tail = &finished;
+    while (list != NULL) {
+        sdo_req_t *req = list;
+        list = req->next;
+        if (req->complete != NULL)
+            req->complete(req);
+        else
+            chBSemSignal(&req->done);
+    }
+}
+
+static bool sdo_busy(uint8_t node_id)
+{
+    for (int i = 0; i < CO_NO_SDO_CLIENT; i++) {
+        if (slots[i].req != NULL && slots[i].req->node_id == node_id)
+            return true;
+    }
+    return false;
+}
+
+/* Fail queued requests that waited longer than their timeout */
+static void sdo_expire(void)
+{
+    systime_t now = chVTGetSystemTimeX();
+    sdo_req_t **pp = &queue;
+
+    while (*pp != NULL) {
+        sdo_req_t *req = *pp;
+        if (chTimeDiffX(req->queued, now) >= TIME_MS2I(req->timeout)) {
+            *pp = req->next;
+            req->abrt_code = CO_SDO_AB_TIMEOUT;
+            sdo_finish(req, CO_SDOcli_endedWithTimeout);
+        } else {
+            pp = &req->next;
+        }
+    }
+}
+
+/* Unlink the oldest request of the idle node served least recently */
+static sdo_req_t *sdo_pick(void)
+{
+    sdo_req_t **best = NULL;
+
+    for (sdo_req_t **pp = &queue; *pp != NULL; pp = &(*pp)->next) {
+        uint8_t node_id = (*pp)->node_id;
+        if (sdo_busy(node_id))
+            continue;
+        if (best == NULL || (int32_t)(served[node_id] - served[(*best)->node_id]) < 0)
+            best = pp;
+    }
+    if (best != NULL) {
+        sdo_req_t *req = *best;
+        *best = req->next;
+        served[req->node_id] = ++stamp;
+        return req;
+    }
+    return NULL;
+}
+
+/* A free client, preferably one already set up for the node */
+static sdo_slot_t *sdo_slot(uint8_t node_id)
+{
+    sdo_slot_t *slot = NULL;
+
+    for (int i = 0; i < CO_NO_SDO_CLIENT; i++) {
+        if (slots[i].req != NULL)
+            continue;
+        if (slots[i].node_id == node_id)
+            return &slots[i];
+        if (slot == NULL)
+            slot = &slots[i];
+    }
+    return slot;
+}
+
+static void sdo_start(sdo_slot_t *slot, sdo_req_t *req)
+{
+    CO_SDOclient_return_t ret = CO_SDOcli_ok_communicationEnd;
+
+    /* Back to back requests to a node skip the COB-ID and CAN filter setup */
+    if (slot->node_id != req->node_id) {
+        slot->node_id = 0;
+        ret = CO_SDOclient_setup(slot->client, 0, 0, req->node_id);
+        if (ret == CO_SDOcli_ok_communicationEnd)
+            slot->node_id = req->node_id;
+    }
+    if (ret == CO_SDOcli_ok_communicationEnd) {
+        if (req->upload)
+            ret = CO_SDOclientUploadInitiate(slot->client, req->index, req->subindex, req->data, req->len, req->block);
+        else
+            ret = CO_SDOclientDownloadInitiate(slot->client, req->index, req->subindex, req->data, req->len, req->block);
+    }
+    if (ret != CO_SDOcli_ok_communicationEnd) {
+        sdo_finish(req, ret);
+        return;
+    }
+    slot->req = req;
+    slot->prev_time = chVTGetSystemTimeX();
+}
+
+/* Start queued requests on the free clients */
+static void sdo_dispatch(void)
+{
+    sdo_req_t *req;
+
+    chMtxLock(&sdo_mtx);
+    sdo_expire();
+    /* While any client is free */
+    while (sdo_slot(0) != NULL && (req = sdo_pick()) != NULL)
+        sdo_start(sdo_slot(req->node_id), req);
+    chMtxUnlock(&sdo_mtx);
+    sdo_complete();
+}
+
+static CO_SDOclient_return_t sdo_step(sdo_slot_t *slot)
+{
+    sdo_req_t *req = slot->req;
+    CO_SDOclient_return_t ret;
+    uint32_t ms;
+
+    /* Only whole elapsed milliseconds are consumed, the rest carries over */
+    ms = chTimeI2MS(chTimeDiffX(slot->prev_time, chVTGetSystemTimeX()));
+    slot->prev_time = chTimeAddX(slot->prev_time, TIME_MS2I(ms));
+    if (req->upload)
+        ret = CO_SDOclientUpload(slot->client, ms, req->timeout, &req->ret_len, &req->abrt_code);
+    else
+        ret = CO_SDOclientDownload(slot->client, ms, req->timeout, &req->abrt_code);
+    if (ret <= 0) {
+        CO_SDOclientClose(slot->client);
+        slot->req = NULL;
+        sdo_finish(req, ret);
+    }
+    return ret;
+}
+
+THD_WORKING_AREA(sdo_pool_wa, CO_MASTER_SDO_WA_SIZE);
+THD_FUNCTION(sdo_pool, arg)
+{
+    (void)arg;
+
+    for (int i = 0; i < CO_NO_SDO_CLIENT; i++) {
+        slots[i].client = CO->SDOclient[i];
+        slots[i].req = NULL;
+        slots[i].node_id = 0;
+        CO_SDOclient_initCallback(slots[i].client, sdo_signal);
+    }
+    chMtxLock(&sdo_mtx);
+    running = true;
+    chMtxUnlock(&sdo_mtx);
+
+    while (!chThdShouldTerminateX()) {
+        sysinterval_t wait = CO_MASTER_SDO_POLL;
+
+        sdo_dispatch();
+        for (int i = 0; i < CO_NO_SDO_CLIENT; i++) {
+            CO_SDOclient_return_t ret;
+
+            if (slots[i].req == NULL)
+                continue;
+            ret = sdo_step(&slots[i]);
+            sdo_complete();
+            if (ret <= 0) {
+                /* A client is free for the next queued request */
+                wait = TIME_IMMEDIATE;
+            } else if (ret != CO_SDOcli_waitingServerResponse) {
+                /* Block download segments go out back to back */
+                if (!slots[i].client->CANtxBuff->bufferFull)
+                    wait = TIME_IMMEDIATE;
+                else if (wait > CO_MASTER_SDO_BACKOFF)
+                    wait = CO_MASTER_SDO_BACKOFF;
+            }
+        }
+
+        if (wait == TIME_IMMEDIATE)
+            chThdYield();
+        else
+            chBSemWaitTimeout(&sdo_bsem, wait);
+    }
+
+    /* Fail everything still in flight or queued */
+    chMtxLock(&sdo_mtx);
+    running = false;
+    for (int i = 0; i < CO_NO_SDO_CLIENT; i++) {
+        if (slots[i].req != NULL) {
+            CO_SDOclientClose(slots[i].client);
+            slots[i].req->abrt_code = CO_SDO_AB_GENERAL;
+            sdo_finish(slots[i].req, CO_SDOcli_endedWithClientAbort);
+            slots[i].req = NULL;
+        }
+    }
+    while (queue != NULL) {
+        sdo_req_t *req = queue;
+        queue = req->next;
+        req->abrt_code = CO_SDO_AB_GENERAL;
+        sdo_finish(req, CO_SDOcli_endedWithClientAbort);
+    }
+    chMtxUnlock(&sdo_mtx);
+    sdo_complete();
+
+    chThdExit(MSG_OK);
+}
+
+static void sdo_init_req(sdo_req_t *req)
+{
+    chBSemObjectInit(&req->done, true);
+    req->status = CO_SDOcli_wrongArguments;
+    req->ret_len = 0;
+    req->abrt_code = CO_SDO_AB_NONE;
+    req->next = NULL;
+}
+
+/*
+ * Queue a batch of transfers under one lock and one pool wakeup, returns
+ * false if the pool is not running. The requests then end with a client
+ * abort and CO_SDO_AB_GENERAL, as on shutdown. Requests to the same node run in array
+ * order. Each request must stay valid until it completes, either through
+ * its callback or sdo_result().
+ */
+bool sdo_submit_batch(sdo_req_t *reqs, size_t n)
+{
+    sdo_req_t **pp;
+    systime_t now;
+
+    for (size_t i = 0; i < n; i++)
+        sdo_init_req(&reqs[i]);
+
+    chMtxLock(&sdo_mtx);
+    if (!running) {
+        chMtxUnlock(&sdo_mtx);
+        for (size_t i = 0; i < n; i++) {
+            reqs[i].abrt_code = CO_SDO_AB_GENERAL;
+            reqs[i].status = CO_SDOcli_endedWithClientAbort;
+        }
+        return false;
+    }
+    now = chVTGetSystemTimeX();
+    for (pp = &queue; *pp != NULL; pp = &(*pp)->next)
+        ;
+    for (size_t i = 0; i < n; i++) {
+        reqs[i].queued = now;
+        *pp = &reqs[i];
+        pp = &reqs[i].next;
+    }
+    chMtxUnlock(&sdo_mtx);
+    chBSemSignal(&sdo_bsem);
+
+    return true;
+}
+
+bool sdo_submit(sdo_req_t *req)
+{
+    return sdo_submit_batch(req, 1);
+}
+
+/* Wait for a submitted transfer without a completion callback */
+CO_SDOclient_return_t sdo_result(sdo_req_t *req)
+{
+    chBSemWait(&req->done);
+    return req->status;
+}
+
+#else
+
+bool sdo_submit_batch(sdo_req_t *reqs, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        reqs[i].ret_len = 0;
+        reqs[i].abrt_code = CO_SDO_AB_GENERAL;
+        reqs[i].status = CO_SDOcli_endedWithClientAbort;
+    }
+    return false;
+}
+
+bool sdo_submit(sdo_req_t *req)
+{
+    return sdo_submit_batch(req, 1);
+}
+
+CO_SDOclient_return_t sdo_result(sdo_req_t *req)
+{
+    return req->status;
+}
+
+#endif /* CO_NO_SDO_CLIENT */
+
+CO_SDOclient_return_t sdo_upload(
         uint8_t         node_id,
         uint16_t        index,
         uint8_t         subindex,
@@ -13,28 +342,26 @@ int sdo_upload(
         uint16_t        timeout,
         bool            block)
 {
-        CO_SDOclient_return_t ret;
-        systime_t prev_time, cur_time, diff_time;
-
-        if (CO_SDOclient_setup(SDOclient, 0, 0, node_id) != CO_SDOcli_ok_communicationEnd)
-            return 1;
-        if (CO_SDOclientUploadInitiate(SDOclient, index, subindex, data, max_len, block) != CO_SDOcli_ok_communicationEnd)
-            return 1;
+    sdo_req_t req = {
+        .node_id = node_id,
+        .index = index,
+        .subindex = subindex,
+        .data = data,
+        .len = max_len,
+        .upload = true,
+        .block = block,
+        .timeout = timeout,
+    };
 
-        prev_time = chVTGetSystemTimeX();
-        do {
-            diff_time = chTimeDiffX(prev_time, cur_time = chVTGetSystemTimeX());
-            prev_time = cur_time;
-            ret = CO_SDOclientUpload(SDOclient, chTimeI2MS(diff_time), timeout, ret_len, abrt_code);
-            chThdSleepMilliseconds(10);
-        } while (ret > 0);
-        CO_SDOclientClose(SDOclient);
+    if (sdo_submit(&req))
+        sdo_result(&req);
+    *ret_len = req.ret_len;
+    *abrt_code = req.abrt_code;
 
-        return 0;
+    return req.status;
 }
 
-int sdo_download(
-        CO_SDOclient_t *SDOclient,
+CO_SDOclient_return_t sdo_download(
         uint8_t         node_id,
         uint16_t        index,
         uint8_t         subindex,
@@ -44,22 +371,20 @@ int sdo_download(
         uint16_t        timeout,
         bool            block)
 {
-    CO_SDOclient_return_t ret;
-    systime_t prev_time, cur_time, diff_time;
-
-    if (CO_SDOclient_setup(SDOclient, 0, 0, node_id) != CO_SDOcli_ok_communicationEnd)
-        return 1;
-    if (CO_SDOclientDownloadInitiate(SDOclient, index, subindex, data, len, block) != CO_SDOcli_ok_communicationEnd)
-        return 1;
-
-    prev_time = chVTGetSystemTimeX();
-    do {
-        diff_time = chTimeDiffX(prev_time, cur_time = chVTGetSystemTimeX());
-        prev_time = cur_time;
-        ret = CO_SDOclientDownload(SDOclient, chTimeI2MS(diff_time), timeout, abrt_code);
-        chThdSleepMilliseconds(5);
-    } while (ret > 0);
-    CO_SDOclientClose(SDOclient);
-
-    return 0;
+    sdo_req_t req = {
+        .node_id = node_id,
+        .index = index,
+        .subindex = subindex,
+        .data = data,
+        .len = len,
+        .upload = false,
+        .block = block,
+        .timeout = timeout,
+    };
+
+    if (sdo_submit(&req))
+        sdo_result(&req);
+    *abrt_code = req.abrt_code;
+
+    return req.status;
 }
@@ -0,0 +1,151 @@
+#include <string.h>
+
+#include "i2c_bus.h"
+
+/* Half of an SCL period while clocking out a stuck slave */
+#define I2C_BUS_RECOVERY_DELAY  TIME_US2I(5)
+#define I2C_BUS_RECOVERY_CLOCKS 9
+
+static i2c_bus_t *buses[I2C_BUS_MAX];
+
+static i2c_bus_t *i2c_bus_find(I2CDriver *i2cp)
+{
+    for (int i = 0; i < I2C_BUS_MAX; i++) {
+        if (buses[i] != NULL && buses[i]->config->i2cp == i2cp)
+            return buses[i];
+    }
+    return NULL;
+}
+
+static i2c_dev_stats_t *i2c_bus_dev(i2c_bus_t *bus, i2caddr_t addr)
+{
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES; i++) {
+        if (bus->dev[i].addr == addr)
+            return &bus->dev[i];
+        if (bus->dev[i].addr == 0) {
+            bus->dev[i].addr = addr;
+            return &bus->dev[i];
+        }
+    }
+    return NULL;
+}
+
+static void i2c_bus_publish(i2c_bus_t *bus)
+{
+    if (bus != NULL && bus->config->update != NULL)
+        bus->config->update(bus);
+}
+
+static void i2c_bus_error(I2CDriver *i2cp, i2caddr_t addr, msg_t ret)
+{
+    i2c_bus_t *bus = i2c_bus_find(i2cp);
+    i2c_dev_stats_t *dev;
+    i2cflags_t errors;
+
+    if (ret == MSG_TIMEOUT) {
+        /* The driver is left locked and the bus may be held by a slave */
+        i2c_bus_recover(i2cp);
+        if (bus == NULL)
+            return;
+        bus->stats.timeout++;
+        dev = i2c_bus_dev(bus, addr);
+        if (dev != NULL)
+            dev->timeout++;
+    } else {
+        if (bus == NULL)
+            return;
+        errors = i2cGetErrors(i2cp);
+        if (errors & I2C_ACK_FAILURE) {
+            bus->stats.nack++;
+            dev = i2c_bus_dev(bus, addr);
+            if (dev != NULL)
+                dev->nack++;
+        }
+        if (errors & I2C_ARBITRATION_LOST)
+            bus->stats.arb_lost++;
+        if (errors & (I2C_BUS_ERROR | I2C_OVERRUN | I2C_PEC_ERROR | I2C_SMB_ALERT))
+            bus->stats.bus_error++;
+        if (errors & I2C_TIMEOUT)
+            bus->stats.timeout++;
+    }
+    i2c_bus_publish(bus);
+}
+
+void i2c_bus_register(i2c_bus_t *bus, const i2c_bus_config_t *config)
+{
+    osalDbgCheck(bus != NULL && config != NULL);
+
+    bus->config = config;
+    memset(&bus->stats, 0, sizeof(bus->stats));
+    memset(bus->dev, 0, sizeof(bus->dev));
+    for (int i = 0; i < I2C_BUS_MAX; i++) {
+        if (buses[i] == NULL || buses[i] == bus) {
+            buses[i] = bus;
+            i2c_bus_publish(bus);
+            return;
+        }
+    }
+    osalDbgAssert(false, "i2c_bus_register(): too many buses");
+}
+
+void i2c_bus_recover(I2CDriver *i2cp)
+{
+    i2c_bus_t *bus = i2c_bus_find(i2cp);
+    const I2CConfig *i2ccfg = i2cp->config;
+
+    i2cStop(i2cp);
+    if (bus != NULL) {
+        const i2c_bus_config_t *config = bus->config;
+
+        /* Clock out a slave that is holding SDA low, then issue a STOP, keeping the pull-ups */
+        palSetLine(config->scl);
+        palSetLine(config->sda);
+        palSetLineMode(config->scl, PAL_MODE_OUTPUT_OPENDRAIN | (config->mode & PAL_STM32_PUPDR_MASK));
+        palSetLineMode(config->sda, PAL_MODE_OUTPUT_OPENDRAIN | (config->mode & PAL_STM32_PUPDR_MASK));
+        for (int i = 0; i < I2C_BUS_RECOVERY_CLOCKS && palReadLine(config->sda) == PAL_LOW; i++) {
+            palClearLine(config->scl);
+            chThdSleep(I2C_BUS_RECOVERY_DELAY);
+            palSetLine(config->scl);
+            chThdSleep(I2C_BUS_RECOVERY_DELAY);
+        }
+        palClearLine(config->scl);
+        chThdSleep(I2C_BUS_RECOVERY_DELAY);
+        palClearLine(config->sda);
+        chThdSleep(I2C_BUS_RECOVERY_DELAY);
+        palSetLine(config->scl);
+        chThdSleep(I2C_BUS_RECOVERY_DELAY);
+        palSetLine(config->sda);
+        chThdSleep(I2C_BUS_RECOVERY_DELAY);
+        palSetLineMode(config->scl, config->mode);
+        palSetLineMode(config->sda, config->mode);
+        bus->stats.recovery++;
+    }
+    i2cStart(i2cp, i2ccfg);
+    i2c_bus_publish(bus);
+}
+
+msg_t i2c_bus_transmit(I2CDriver *i2cp, i2caddr_t addr, const uint8_t *txbuf, size_t txbytes,
+        uint8_t *rxbuf, size_t rxbytes, sysinterval_t timeout)
+{
+    msg_t ret;
+
+    if (timeout == TIME_INFINITE)
+        timeout = I2C_BUS_TIMEOUT;
+    ret = i2cMasterTransmitTimeout(i2cp, addr, txbuf, txbytes, rxbuf, rxbytes, timeout);
+    if (ret != MSG_OK)
+        i2c_bus_error(i2cp, addr, ret);
+    return ret;
+}
+
+msg_t i2c_bus_receive(I2CDriver *i2cp, i2caddr_t addr, uint8_t *rxbuf, size_t rxbytes,
+        sysinterval_t timeout)
+{
+    msg_t ret;
+
+    if (timeout == TIME_INFINITE)
+        timeout = I2C_BUS_TIMEOUT;
+    ret = i2cMasterReceiveTimeout(i2cp, addr, rxbuf, rxbytes, timeout);
+    if (ret != MSG_OK)
+        i2c_bus_error(i2cp, addr, ret);
+    return ret;
+}
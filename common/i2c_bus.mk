@@ -0,0 +1,12 @@
+# List of all the I2C bus health source files, guarded since several
+# device drivers pull this in
+ifeq ($(I2CBUSSRC),)
+I2CBUSSRC := $(PROJ_SRC)/i2c_bus.c
+
+# Required include directories
+I2CBUSINC := $(PROJ_SRC)/include
+
+# Shared variables
+ALLCSRC += $(I2CBUSSRC)
+ALLINC  += $(I2CBUSINC)
+endif
@@ -9,6 +9,7 @@
 
 #include "hal.h"
 #include "ina226.h"
+#include "i2c_bus.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -51,8 +52,8 @@ typedef union {
  */
 msg_t ina226I2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
         uint8_t* rxbuf, size_t n) {
-    return i2cMasterTransmitTimeout(i2cp, sad, &reg, 1, rxbuf, n,
-            TIME_INFINITE);
+    return i2c_bus_transmit(i2cp, sad, &reg, 1, rxbuf, n,
+            INA226_I2C_TIMEOUT);
 }
 
 /**
@@ -69,8 +70,8 @@ msg_t ina226I2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
  */
 msg_t ina226I2CWriteRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t *txbuf,
         size_t n) {
-    return i2cMasterTransmitTimeout(i2cp, sad, txbuf, n, NULL, 0,
-            TIME_INFINITE);
+    return i2c_bus_transmit(i2cp, sad, txbuf, n, NULL, 0,
+            INA226_I2C_TIMEOUT);
 }
 #endif /* INA226_USE_I2C */
 
@@ -217,6 +218,42 @@ void ina226SetAlert(INA226Driver *devp, uint16_t alert_me, uint16_t alert_lim) {
 #endif /* INA226_USE_I2C */
 }
 
+/**
+ * @brief   Starts a single conversion.
+ * @note    Only meaningful when the configured mode is triggered, rewriting
+ *          the configuration register starts a conversion of the selected
+ *          channels.
+ *
+ * @param[in] devp       pointer to the @p INA226Driver object
+ * @return               the operation status.
+ *
+ * @api
+ */
+msg_t ina226Trigger(INA226Driver *devp) {
+    msg_t ret = MSG_OK;
+    i2cbuf_t buf;
+
+    osalDbgCheck(devp != NULL);
+    osalDbgAssert(devp->state == INA226_READY,
+            "ina226Trigger(), invalid state");
+
+#if INA226_USE_I2C
+#if INA226_SHARED_I2C
+    i2cAcquireBus(devp->config->i2cp);
+    i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* INA226_SHARED_I2C */
+
+    buf.reg = INA226_AD_CONFIG;
+    buf.value = __REVSH(devp->config->cfg);
+    ret = ina226I2CWriteRegister(devp->config->i2cp, devp->config->saddr, buf.buf, sizeof(buf));
+
+#if INA226_SHARED_I2C
+    i2cReleaseBus(devp->config->i2cp);
+#endif /* INA226_SHARED_I2C */
+#endif /* INA226_USE_I2C */
+    return ret;
+}
+
 /**
  * @brief   Reads INA226 Register as raw value.
  *
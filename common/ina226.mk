@@ -1,3 +1,6 @@
+# Required libraries for the INA226
+include $(PROJ_SRC)/i2c_bus.mk
+
 # List of all the INA226 device files.
 INA226SRC := $(PROJ_SRC)/ina226.c
 
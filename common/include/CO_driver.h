@@ -58,7 +58,24 @@ extern "C" {
 #include "hal.h"
 
 #define CO_USE_GLOBALS
-#define CO_SDO_BUFFER_SIZE           889    /* Override default SDO buffer size. */
+
+/* Receive monitor slots, see CO_CANrxMonitorInit() */
+#ifndef CO_CAN_RX_MONITORS
+#define CO_CAN_RX_MONITORS           3
+#endif
+
+/*
+ * SDO block size in 7 byte segments. The SDO buffer holds exactly one block,
+ * domain objects larger than that are streamed block by block (see
+ * sdo_stream.h). The buffer must still fit the largest non-domain OD entry.
+ */
+#ifndef CO_SDO_BLOCK_SEGMENTS
+#define CO_SDO_BLOCK_SEGMENTS        127
+#endif
+#if CO_SDO_BLOCK_SEGMENTS < 1 || CO_SDO_BLOCK_SEGMENTS > 127
+#error "CO_SDO_BLOCK_SEGMENTS must be in the range 1-127"
+#endif
+#define CO_SDO_BUFFER_SIZE           (7 * CO_SDO_BLOCK_SEGMENTS)    /* Override default SDO buffer size. */
 
 /**
  * @defgroup CO_driver Driver
@@ -463,6 +480,25 @@ CO_ReturnError_t CO_CANrxBufferInit(
         void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message));
 
 
+/**
+ * Configure CAN receive monitor.
+ *
+ * A monitor is called for every received CAN message, matched by a receive
+ * buffer or not, so CAN module filters are not used while one is set. It is
+ * called from the CAN receive interrupt and must be fast. It must be set
+ * before CO_CANmodule_init() to take effect on the filters.
+ *
+ * @param index Monitor slot, less than CO_CAN_RX_MONITORS.
+ * @param object Object passed to pFunct.
+ * @param pFunct Pointer to function called for each received message, NULL
+ * to remove the monitor.
+ */
+void CO_CANrxMonitorInit(
+        uint16_t                index,
+        void                   *object,
+        void                  (*pFunct)(void *object, const CO_CANrxMsg_t *message));
+
+
 /**
  * Configure CAN message transmit buffer.
  *
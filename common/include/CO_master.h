@@ -5,11 +5,68 @@
 extern "C" {
 #endif
 
+#include "ch.h"
 #include "CANopen.h"
 #include "CO_SDOmaster.h"
 
-int sdo_upload(
-        CO_SDOclient_t *SDOclient,
+/* Longest wait for a server response before the transfer timeouts are rechecked */
+#ifndef CO_MASTER_SDO_POLL
+#define CO_MASTER_SDO_POLL      TIME_MS2I(10)
+#endif
+
+/* Pause between block download segments when the CAN TX buffer is full */
+#ifndef CO_MASTER_SDO_BACKOFF
+#define CO_MASTER_SDO_BACKOFF   TIME_MS2I(1)
+#endif
+
+#ifndef CO_MASTER_SDO_WA_SIZE
+#define CO_MASTER_SDO_WA_SIZE   0x200
+#endif
+
+/*
+ * SDO client pool. Every SDO client of the node runs one transfer, so up to
+ * CO_NO_SDO_CLIENT nodes are served in parallel. Requests for a node that
+ * already has a transfer in flight stay queued, and when a client frees up
+ * it goes to the queued node that was served least recently.
+ */
+typedef struct sdo_req sdo_req_t;
+
+/* Completion callback, runs on the pool thread and may submit new requests */
+typedef void (*sdo_cb_t)(sdo_req_t *req);
+
+struct sdo_req {
+    uint8_t node_id;
+    uint16_t index;
+    uint8_t subindex;
+    void *data;
+    uint32_t len;               /* Buffer size for an upload, data size for a download */
+    bool upload;
+    bool block;
+    uint16_t timeout;           /* ms, applies to the queue wait and to each server response */
+    sdo_cb_t complete;          /* NULL to wait with sdo_result() instead */
+    void *arg;
+    /* Results */
+    CO_SDOclient_return_t status;
+    uint32_t ret_len;
+    uint32_t abrt_code;
+    /* Pool private */
+    binary_semaphore_t done;
+    systime_t queued;
+    struct sdo_req *next;
+};
+
+#if CO_NO_SDO_CLIENT != 0
+extern THD_WORKING_AREA(sdo_pool_wa, CO_MASTER_SDO_WA_SIZE);
+extern THD_FUNCTION(sdo_pool, arg);
+#endif
+
+bool sdo_submit(sdo_req_t *req);
+bool sdo_submit_batch(sdo_req_t *reqs, size_t n);
+CO_SDOclient_return_t sdo_result(sdo_req_t *req);
+
+/* Blocking single transfers */
+
+CO_SDOclient_return_t sdo_upload(
         uint8_t         node_id,
         uint16_t        index,
         uint8_t         subindex,
@@ -20,8 +77,7 @@ int sdo_upload(
         uint16_t        timeout,
         bool            block);
 
-int sdo_download(
-        CO_SDOclient_t *SDOclient,
+CO_SDOclient_return_t sdo_download(
         uint8_t         node_id,
         uint16_t        index,
         uint8_t         subindex,
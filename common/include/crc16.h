@@ -0,0 +1,47 @@
+#ifndef _CRC16_H_
+#define _CRC16_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/*
+ * CRC-16-CCITT backend for the SDO block transfer CRC, replacing the
+ * CANopenNode crc16-ccitt.c. CRC16_USE_HW selects the STM32 CRC unit and
+ * needs a part with a programmable polynomial (F07x/F09x, L4), otherwise
+ * a table with CRC16_SLICES bytes per step (1, 2 or 4) is used.
+ */
+#if !defined(CRC16_USE_HW)
+#if defined(CRC_CR_POLYSIZE)
+#define CRC16_USE_HW            TRUE
+#else
+#define CRC16_USE_HW            FALSE
+#endif
+#endif
+
+#if !defined(CRC16_SLICES)
+#define CRC16_SLICES            4
+#endif
+
+/* Bytes fed to the CRC unit per kernel lock */
+#if !defined(CRC16_HW_CHUNK)
+#define CRC16_HW_CHUNK          64
+#endif
+
+#if CRC16_USE_HW && !defined(CRC_CR_POLYSIZE)
+#error "CRC16_USE_HW requires a CRC unit with a programmable polynomial"
+#endif
+
+#if CRC16_SLICES != 1 && CRC16_SLICES != 2 && CRC16_SLICES != 4
+#error "CRC16_SLICES must be 1, 2 or 4"
+#endif
+
+void crc16_init(void);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
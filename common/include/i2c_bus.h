@@ -0,0 +1,69 @@
+#ifndef _I2C_BUS_H_
+#define _I2C_BUS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/* Deadline of transfers started without one (TIME_INFINITE) */
+#if !defined(I2C_BUS_TIMEOUT)
+#define I2C_BUS_TIMEOUT         TIME_MS2I(10)
+#endif
+
+/* Maximum number of buses under supervision */
+#if !defined(I2C_BUS_MAX)
+#define I2C_BUS_MAX             2
+#endif
+
+/* Number of slave addresses tracked per bus */
+#if !defined(I2C_BUS_MAX_DEVICES)
+#define I2C_BUS_MAX_DEVICES     8
+#endif
+
+typedef struct i2c_bus i2c_bus_t;
+
+/* Called after the counters of a bus change, from the thread of the failed transfer */
+typedef void (*i2c_bus_cb_t)(const i2c_bus_t *bus);
+
+typedef struct {
+    I2CDriver *i2cp;
+    ioline_t scl;
+    ioline_t sda;
+    iomode_t mode;              /* Pad mode restored after recovery, with the board's pull-ups */
+    i2c_bus_cb_t update;        /* Publishes the counters, NULL if unused */
+} i2c_bus_config_t;
+
+typedef struct {
+    uint32_t nack;
+    uint32_t arb_lost;
+    uint32_t bus_error;
+    uint32_t timeout;
+    uint32_t recovery;
+} i2c_bus_stats_t;
+
+typedef struct {
+    i2caddr_t addr;
+    uint16_t nack;
+    uint16_t timeout;
+} i2c_dev_stats_t;
+
+struct i2c_bus {
+    const i2c_bus_config_t *config;
+    i2c_bus_stats_t stats;
+    i2c_dev_stats_t dev[I2C_BUS_MAX_DEVICES];
+};
+
+void i2c_bus_register(i2c_bus_t *bus, const i2c_bus_config_t *config);
+void i2c_bus_recover(I2CDriver *i2cp);
+msg_t i2c_bus_transmit(I2CDriver *i2cp, i2caddr_t addr, const uint8_t *txbuf, size_t txbytes,
+        uint8_t *rxbuf, size_t rxbytes, sysinterval_t timeout);
+msg_t i2c_bus_receive(I2CDriver *i2cp, i2caddr_t addr, uint8_t *rxbuf, size_t rxbytes,
+        sysinterval_t timeout);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
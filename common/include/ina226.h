@@ -80,14 +80,14 @@
 #define INA226_CONFIG_VBUSCT_Pos            (6U)
 #define INA226_CONFIG_VBUSCT_Msk            (0x7U << INA226_CONFIG_VBUSCT_Pos)
 #define INA226_CONFIG_VBUSCT                INA226_CONFIG_VBUSCT_Msk
-#define INA226_CONFIG_VBUSCT_140US          (0x0U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_204US          (0x1U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_332US          (0x2U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_588US          (0x3U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_1100US         (0x4U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_2116US         (0x5U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_4156US         (0x6U << INA226_CONFIG_VSHCT_Pos)
-#define INA226_CONFIG_VBUSCT_8224US         (0x7U << INA226_CONFIG_VSHCT_Pos)
+#define INA226_CONFIG_VBUSCT_140US          (0x0U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_204US          (0x1U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_332US          (0x2U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_588US          (0x3U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_1100US         (0x4U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_2116US         (0x5U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_4156US         (0x6U << INA226_CONFIG_VBUSCT_Pos)
+#define INA226_CONFIG_VBUSCT_8224US         (0x7U << INA226_CONFIG_VBUSCT_Pos)
 #define INA226_CONFIG_AVG_Pos               (9U)
 #define INA226_CONFIG_AVG_Msk               (0x7U << INA226_CONFIG_AVG_Pos)
 #define INA226_CONFIG_AVG                   INA226_CONFIG_AVG_Msk
@@ -244,6 +244,15 @@
 #if !defined(INA226_SHARED_I2C) || defined(__DOXYGEN__)
 #define INA226_SHARED_I2C                   FALSE
 #endif
+
+/**
+ * @brief   INA226 I2C transaction timeout.
+ * @details A transaction that times out triggers I2C bus recovery.
+ * @note    The default is 10 ms.
+ */
+#if !defined(INA226_I2C_TIMEOUT) || defined(__DOXYGEN__)
+#define INA226_I2C_TIMEOUT                  TIME_MS2I(10)
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -368,6 +377,7 @@ void ina226ObjectInit(INA226Driver *devp);
 void ina226Start(INA226Driver *devp, const INA226Config *config);
 void ina226Stop(INA226Driver *devp);
 void ina226SetAlert(INA226Driver *devp, uint16_t alert_me, uint16_t alert_lim);
+msg_t ina226Trigger(INA226Driver *devp);
 uint16_t ina226ReadRaw(INA226Driver *devp, uint8_t reg);
 int16_t ina226ReadShunt(INA226Driver *devp);
 uint16_t ina226ReadVBUS(INA226Driver *devp);
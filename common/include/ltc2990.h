@@ -0,0 +1,358 @@
+/**
+ * @file    ltc2990.h
+ * @brief   LTC2990 Quad I2C Voltage, Current and Temperature Monitor.
+ *
+ * @addtogroup LTC2990
+ * @ingroup ORESAT
+ * @{
+ */
+#ifndef _LTC2990_H_
+#define _LTC2990_H_
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Version Identification
+ * @{
+ */
+/**
+ * @brief   LTC2990 Driver version string.
+ */
+#define LTC2990_VERSION                     "1.0.0"
+
+/**
+ * @brief   LTC2990 Driver version major number.
+ */
+#define LTC2990_MAJOR                       1
+
+/**
+ * @brief   LTC2990 Driver version minor number.
+ */
+#define LTC2990_MINOR                       0
+
+/**
+ * @brief   LTC2990 Driver version patch number.
+ */
+#define LTC2990_PATCH                       0
+/** @} */
+
+/**
+ * @name    LTC2990 Register Addresses
+ * @{
+ */
+#define LTC2990_AD_STATUS                   0x00U
+#define LTC2990_AD_CONTROL                  0x01U
+#define LTC2990_AD_TRIGGER                  0x02U
+#define LTC2990_AD_TINT_MSB                 0x04U
+#define LTC2990_AD_TINT_LSB                 0x05U
+#define LTC2990_AD_V1_MSB                   0x06U
+#define LTC2990_AD_V1_LSB                   0x07U
+#define LTC2990_AD_V2_MSB                   0x08U
+#define LTC2990_AD_V2_LSB                   0x09U
+#define LTC2990_AD_V3_MSB                   0x0AU
+#define LTC2990_AD_V3_LSB                   0x0BU
+#define LTC2990_AD_V4_MSB                   0x0CU
+#define LTC2990_AD_V4_LSB                   0x0DU
+#define LTC2990_AD_VCC_MSB                  0x0EU
+#define LTC2990_AD_VCC_LSB                  0x0FU
+#define LTC2990_NUM_REGS                    16
+/** @} */
+
+/**
+ * @name    LTC2990 Status register fields
+ * @{
+ */
+#define LTC2990_STATUS_BUSY_Pos             (0U)
+#define LTC2990_STATUS_BUSY_Msk             (0x1U << LTC2990_STATUS_BUSY_Pos)
+#define LTC2990_STATUS_BUSY                 LTC2990_STATUS_BUSY_Msk
+#define LTC2990_STATUS_TINT_RDY_Pos         (1U)
+#define LTC2990_STATUS_TINT_RDY_Msk         (0x1U << LTC2990_STATUS_TINT_RDY_Pos)
+#define LTC2990_STATUS_TINT_RDY             LTC2990_STATUS_TINT_RDY_Msk
+#define LTC2990_STATUS_V1_RDY_Pos           (2U)
+#define LTC2990_STATUS_V1_RDY_Msk           (0x1U << LTC2990_STATUS_V1_RDY_Pos)
+#define LTC2990_STATUS_V1_RDY               LTC2990_STATUS_V1_RDY_Msk
+#define LTC2990_STATUS_V2_RDY_Pos           (3U)
+#define LTC2990_STATUS_V2_RDY_Msk           (0x1U << LTC2990_STATUS_V2_RDY_Pos)
+#define LTC2990_STATUS_V2_RDY               LTC2990_STATUS_V2_RDY_Msk
+#define LTC2990_STATUS_V3_RDY_Pos           (4U)
+#define LTC2990_STATUS_V3_RDY_Msk           (0x1U << LTC2990_STATUS_V3_RDY_Pos)
+#define LTC2990_STATUS_V3_RDY               LTC2990_STATUS_V3_RDY_Msk
+#define LTC2990_STATUS_V4_RDY_Pos           (5U)
+#define LTC2990_STATUS_V4_RDY_Msk           (0x1U << LTC2990_STATUS_V4_RDY_Pos)
+#define LTC2990_STATUS_V4_RDY               LTC2990_STATUS_V4_RDY_Msk
+#define LTC2990_STATUS_VCC_RDY_Pos          (6U)
+#define LTC2990_STATUS_VCC_RDY_Msk          (0x1U << LTC2990_STATUS_VCC_RDY_Pos)
+#define LTC2990_STATUS_VCC_RDY              LTC2990_STATUS_VCC_RDY_Msk
+/** @} */
+
+/**
+ * @name    LTC2990 Control register fields
+ * @{
+ */
+#define LTC2990_CONTROL_MODE_Pos            (0U)
+#define LTC2990_CONTROL_MODE_Msk            (0x7U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE                LTC2990_CONTROL_MODE_Msk
+#define LTC2990_CONTROL_MODE_V1_V2_TR2      (0x0U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_V12_TR2        (0x1U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_V12_V3_V4      (0x2U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_TR1_V3_V4      (0x3U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_TR1_V34        (0x4U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_TR1_TR2        (0x5U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_V12_V34        (0x6U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MODE_V1_V2_V3_V4    (0x7U << LTC2990_CONTROL_MODE_Pos)
+#define LTC2990_CONTROL_MEAS_Pos            (3U)
+#define LTC2990_CONTROL_MEAS_Msk            (0x3U << LTC2990_CONTROL_MEAS_Pos)
+#define LTC2990_CONTROL_MEAS                LTC2990_CONTROL_MEAS_Msk
+#define LTC2990_CONTROL_MEAS_TINT           (0x0U << LTC2990_CONTROL_MEAS_Pos)
+#define LTC2990_CONTROL_MEAS_TR1_V1         (0x1U << LTC2990_CONTROL_MEAS_Pos)
+#define LTC2990_CONTROL_MEAS_TR2_V3         (0x2U << LTC2990_CONTROL_MEAS_Pos)
+#define LTC2990_CONTROL_MEAS_ALL            (0x3U << LTC2990_CONTROL_MEAS_Pos)
+#define LTC2990_CONTROL_SINGLE_Pos          (6U)
+#define LTC2990_CONTROL_SINGLE_Msk          (0x1U << LTC2990_CONTROL_SINGLE_Pos)
+#define LTC2990_CONTROL_SINGLE              LTC2990_CONTROL_SINGLE_Msk
+#define LTC2990_CONTROL_KELVIN_Pos          (7U)
+#define LTC2990_CONTROL_KELVIN_Msk          (0x1U << LTC2990_CONTROL_KELVIN_Pos)
+#define LTC2990_CONTROL_KELVIN              LTC2990_CONTROL_KELVIN_Msk
+/** @} */
+
+/**
+ * @name    LTC2990 Result register MSB fields
+ * @{
+ */
+#define LTC2990_MSB_DV_Pos                  (7U)
+#define LTC2990_MSB_DV_Msk                  (0x1U << LTC2990_MSB_DV_Pos)
+#define LTC2990_MSB_DV                      LTC2990_MSB_DV_Msk
+#define LTC2990_MSB_SS_Pos                  (6U)
+#define LTC2990_MSB_SS_Msk                  (0x1U << LTC2990_MSB_SS_Pos)
+#define LTC2990_MSB_SS                      LTC2990_MSB_SS_Msk
+#define LTC2990_MSB_SO_Pos                  (5U)
+#define LTC2990_MSB_SO_Msk                  (0x1U << LTC2990_MSB_SO_Pos)
+#define LTC2990_MSB_SO                      LTC2990_MSB_SO_Msk
+/** @} */
+
+/**
+ * @name    LTC2990 Channel indexes in @p ltc2990_data_t
+ * @{
+ */
+#define LTC2990_CH_TINT                     0U
+#define LTC2990_CH_V1                       1U
+#define LTC2990_CH_V2                       2U
+#define LTC2990_CH_V3                       3U
+#define LTC2990_CH_V4                       4U
+#define LTC2990_CH_VCC                      5U
+#define LTC2990_NUM_CH                      6U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   LTC2990 I2C interface switch.
+ * @details If set to @p TRUE the support for I2C is included.
+ * @note    The default is @p TRUE.
+ */
+#if !defined(LTC2990_USE_I2C) || defined(__DOXYGEN__)
+#define LTC2990_USE_I2C                     TRUE
+#endif
+
+/**
+ * @brief   LTC2990 shared I2C switch.
+ * @details If set to @p TRUE the device acquires I2C bus ownership
+ *          on each transaction.
+ * @note    The default is @p FALSE. Requires I2C_USE_MUTUAL_EXCLUSION.
+ */
+#if !defined(LTC2990_SHARED_I2C) || defined(__DOXYGEN__)
+#define LTC2990_SHARED_I2C                  FALSE
+#endif
+
+/**
+ * @brief   LTC2990 I2C transaction timeout.
+ * @details A transaction that times out triggers I2C bus recovery.
+ * @note    The default is 10 ms.
+ */
+#if !defined(LTC2990_I2C_TIMEOUT) || defined(__DOXYGEN__)
+#define LTC2990_I2C_TIMEOUT                 TIME_MS2I(10)
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if LTC2990_USE_I2C && !HAL_USE_I2C
+#error "LTC2990_USE_I2C requires HAL_USE_I2C"
+#endif
+
+#if LTC2990_SHARED_I2C && !I2C_USE_MUTUAL_EXCLUSION
+#error "LTC2990_SHARED_I2C requires I2C_USE_MUTUAL_EXCLUSION"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    LTC2990 data structures and types.
+ * @{
+ */
+/**
+ * @brief Structure representing a LTC2990 driver.
+ */
+typedef struct LTC2990Driver LTC2990Driver;
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+    LTC2990_UNINIT = 0,                 /**< Not initialized.                 */
+    LTC2990_STOP = 1,                   /**< Stopped.                         */
+    LTC2990_READY = 2,                  /**< Ready.                           */
+} ltc2990_state_t;
+
+/**
+ * @brief   LTC2990 burst readout of all channels.
+ * @details Results are sign extended raw codes, a channel is only
+ *          meaningful when its bit in @p valid is set.
+ */
+typedef struct {
+    /**
+     * @brief Status register.
+     */
+    uint8_t                     status;
+    /**
+     * @brief Channels with the data valid bit set, by channel index.
+     */
+    uint8_t                     valid;
+    /**
+     * @brief Remote sensor short or open flags, by channel index.
+     */
+    uint8_t                     fault;
+    /**
+     * @brief Raw results, by channel index.
+     */
+    int16_t                     raw[LTC2990_NUM_CH];
+} ltc2990_data_t;
+
+/**
+ * @brief   LTC2990 configuration structure.
+ */
+typedef struct {
+#if (LTC2990_USE_I2C) || defined(__DOXYGEN__)
+    /**
+     * @brief I2C driver associated with this LTC2990.
+     */
+    I2CDriver                   *i2cp;
+    /**
+     * @brief I2C configuration associated with this LTC2990.
+     */
+    const I2CConfig             *i2ccfg;
+    /**
+     * @brief LTC2990 Slave Address
+     */
+    i2caddr_t                   saddr;
+#endif /* LTC2990_USE_I2C */
+    /**
+     * @brief LTC2990 control reg value
+     * @note  Without @p LTC2990_CONTROL_SINGLE the device converts
+     *        continuously after start.
+     */
+    uint8_t                     control;
+} LTC2990Config;
+
+/**
+ * @brief   @p LTC2990 specific methods.
+ */
+#define _ltc2990_methods_alone
+
+/**
+ * @brief   @p LTC2990 specific methods with inherited ones.
+ */
+#define _ltc2990_methods                                                    \
+    _base_object_methods
+
+/**
+ * @extends BaseObjectVMT
+ *
+ * @brief   @p LTC2990 virtual methods table.
+ */
+struct LTC2990VMT {
+    _ltc2990_methods
+};
+
+/**
+ * @brief   @p LTC2990Driver specific data.
+ */
+#define _ltc2990_data                                                       \
+    _base_object_data                                                       \
+    /* Driver state.*/                                                      \
+    ltc2990_state_t             state;                                      \
+    /* Current configuration data.*/                                        \
+    const LTC2990Config         *config;
+
+/**
+ * @brief LTC2990 Voltage, Current and Temperature Monitor class.
+ */
+struct LTC2990Driver {
+    /** @brief Virtual Methods Table.*/
+    const struct LTC2990VMT     *vmt;
+    _ltc2990_data
+};
+
+/** @} */
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @name    LTC2990 result conversions
+ * @{
+ */
+/**
+ * @brief   Single ended voltage in uV, 305.18 uV per LSB.
+ */
+#define LTC2990_SE_TO_UV(raw)               (((int32_t)(raw) * 30518) / 100)
+
+/**
+ * @brief   Differential voltage in nV, 19.42 uV per LSB.
+ */
+#define LTC2990_DIFF_TO_NV(raw)             ((int32_t)(raw) * 19420)
+
+/**
+ * @brief   Temperature in mC or mK, 0.0625 degrees per LSB.
+ */
+#define LTC2990_TEMP_TO_MDEG(raw)           (((int32_t)(raw) * 625) / 10)
+
+/**
+ * @brief   VCC in mV, 2.5 V offset plus 305.18 uV per LSB.
+ */
+#define LTC2990_VCC_TO_MV(raw)              (2500 + ((int32_t)(raw) * 30518) / 100000)
+/** @} */
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void ltc2990ObjectInit(LTC2990Driver *devp);
+void ltc2990Start(LTC2990Driver *devp, const LTC2990Config *config);
+void ltc2990Stop(LTC2990Driver *devp);
+msg_t ltc2990Trigger(LTC2990Driver *devp);
+msg_t ltc2990ReadStatus(LTC2990Driver *devp, uint8_t *status);
+msg_t ltc2990ReadAll(LTC2990Driver *devp, ltc2990_data_t *data);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LTC2990_H_ */
+
+/** @} */
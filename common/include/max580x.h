@@ -110,6 +110,7 @@
  * @name    MAX580X RETURN/CODE Data Fields
  * @{
  */
+#define MAX580X_CODE_UNKNOWN                0xFFFFU
 #define MAX580X_DAC2VAL(field,res)          __REVSH(field >> (16 - res))
 #define MAX580X_VAL2DAC(val,res)            __REVSH(val << (16 - res))
 /** @} */
@@ -140,6 +141,15 @@
 #if !defined(MAX580X_SHARED_I2C) || defined(__DOXYGEN__)
 #define MAX580X_SHARED_I2C                  FALSE
 #endif
+
+/**
+ * @brief   MAX580X I2C transaction timeout.
+ * @details A transaction that times out triggers I2C bus recovery.
+ * @note    The default is 10 ms.
+ */
+#if !defined(MAX580X_I2C_TIMEOUT) || defined(__DOXYGEN__)
+#define MAX580X_I2C_TIMEOUT                 TIME_MS2I(10)
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -191,6 +201,7 @@ typedef enum {
 typedef enum {
     MAX580X_RETURN = MAX580X_AD_RETURN,
     MAX580X_CODE = MAX580X_AD_CODE,
+    MAX580X_LOAD = MAX580X_AD_LOAD,
     MAX580X_CODE_LOAD = MAX580X_AD_CODE_LOAD,
 } max580x_reg_t;
 
@@ -269,7 +280,11 @@ struct MAX580XVMT {
     /* Current configuration data.*/                                        \
     const MAX580XConfig       *config;                                      \
     max580x_res_t             res;                                          \
-    uint16_t                  range;
+    uint16_t                  range;                                        \
+    /* Cached CODE register value.*/                                        \
+    uint16_t                  code;                                         \
+    /* Cached DAC output value.*/                                           \
+    uint16_t                  dac;
 
 /**
  * @brief MAX710 GPIO Expander class.
@@ -297,10 +312,13 @@ void max580xObjectInit(MAX580XDriver *devp);
 void max580xStart(MAX580XDriver *devp, const MAX580XConfig *config);
 void max580xStop(MAX580XDriver *devp);
 uint16_t max580xReadRaw(MAX580XDriver *devp, max580x_reg_t reg);
-void max580xWriteRaw(MAX580XDriver *devp, max580x_reg_t reg, uint16_t value);
+msg_t max580xWriteRaw(MAX580XDriver *devp, max580x_reg_t reg, uint16_t value);
 uint32_t max580xReadVoltage(MAX580XDriver *devp, max580x_reg_t reg);
-void max580xWriteVoltage(MAX580XDriver *devp, max580x_reg_t reg, uint32_t voltage);
-void max580xLoad(MAX580XDriver *devp);
+msg_t max580xWriteVoltage(MAX580XDriver *devp, max580x_reg_t reg, uint32_t voltage);
+msg_t max580xLoad(MAX580XDriver *devp);
+void max580xStageRaw(MAX580XDriver *devp, uint16_t value);
+void max580xStageVoltage(MAX580XDriver *devp, uint32_t voltage);
+void max580xCommit(MAX580XDriver *devs[], size_t n);
 #ifdef __cplusplus
 }
 #endif
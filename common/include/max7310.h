@@ -58,6 +58,7 @@
 #define MAX7310_AD_POL                      0x02
 #define MAX7310_AD_MODE                     0x03
 #define MAX7310_AD_TIMEOUT                  0x04
+#define MAX7310_NUM_REGS                    5
 /** @} */
 
 /**
@@ -126,6 +127,15 @@
 #if !defined(MAX7310_SHARED_I2C) || defined(__DOXYGEN__)
 #define MAX7310_SHARED_I2C                  FALSE
 #endif
+
+/**
+ * @brief   MAX7310 I2C transaction timeout.
+ * @details A transaction that times out triggers I2C bus recovery.
+ * @note    The default is 10 ms.
+ */
+#if !defined(MAX7310_I2C_TIMEOUT) || defined(__DOXYGEN__)
+#define MAX7310_I2C_TIMEOUT                 TIME_MS2I(10)
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -270,6 +280,7 @@ void max7310ObjectInit(MAX7310Driver *devp);
 void max7310Start(MAX7310Driver *devp, const MAX7310Config *config);
 void max7310Stop(MAX7310Driver *devp);
 uint8_t max7310ReadRaw(MAX7310Driver *devp, uint8_t reg);
+msg_t max7310ReadBurst(MAX7310Driver *devp, uint8_t reg, uint8_t *buf, size_t n);
 void max7310WriteRaw(MAX7310Driver *devp, uint8_t reg, uint8_t value);
 void max7310SetPin(MAX7310Driver *devp, uint8_t pin);
 void max7310ClearPin(MAX7310Driver *devp, uint8_t pin);
@@ -1,6 +1,58 @@
 #ifndef OPD_H
 #define OPD_H
 
+#include "ch.h"
+#include "hal.h"
+
+/* Address probe timeout, short enough to only catch the address ACK */
+#if !defined(OPD_PROBE_TIMEOUT)
+#define OPD_PROBE_TIMEOUT   TIME_US2I(500)
+#endif
+
+/* Background rescan period for card insert/remove detection (ms) */
+#if !defined(OPD_RESCAN_INTERVAL)
+#define OPD_RESCAN_INTERVAL 1000
+#endif
+
+/* Fault input polling period (ms), the MAX7310 has no interrupt output */
+#if !defined(OPD_FAULT_POLL_INTERVAL)
+#define OPD_FAULT_POLL_INTERVAL 10
+#endif
+
+/* Circuit breaker reset pulse width (ms) */
+#if !defined(OPD_RESET_PULSE)
+#define OPD_RESET_PULSE     10
+#endif
+
+/* Automatic reset policy: first retry after OPD_RESET_BACKOFF ms, doubling
+ * on every further trip, until OPD_RESET_RETRIES is reached and the card is
+ * latched off. Retries are forgotten after OPD_FAULT_CLEAR_TIME ms without a
+ * trip. */
+#if !defined(OPD_RESET_BACKOFF)
+#define OPD_RESET_BACKOFF   100
+#endif
+
+#if !defined(OPD_RESET_RETRIES)
+#define OPD_RESET_RETRIES   5
+#endif
+
+#if !defined(OPD_FAULT_CLEAR_TIME)
+#define OPD_FAULT_CLEAR_TIME 10000
+#endif
+
+#if !defined(OPD_MONITOR_WA_SIZE)
+#define OPD_MONITOR_WA_SIZE 0x200
+#endif
+
+#if !defined(OPD_MONITOR_PRIO)
+#define OPD_MONITOR_PRIO    LOWPRIO
+#endif
+
+/* Event flags broadcast on opd_event */
+#define OPD_EVENT_INSERT    0x01U
+#define OPD_EVENT_REMOVE    0x02U
+#define OPD_EVENT_TRIP      0x04U
+
 /* IO Pin Assignments */
 #define OPD_SCL             3U /* TODO: Revert this when the time comes */
 #define OPD_SDA             4U /* TODO: Revert this when the time comes */
@@ -43,6 +95,26 @@ typedef enum {
     OPD_PROTOCARD3 = 0x1A,
 } opd_addr_t;
 
+/* Batch operation bits, applied in this order */
+#define OPD_OP_ENABLE       0x01U
+#define OPD_OP_DISABLE      0x02U
+#define OPD_OP_RESET        0x04U
+
+typedef struct {
+    opd_addr_t addr;
+    uint8_t ops;
+} opd_op_t;
+
+typedef enum {
+    OPD_CARD_OK = 0,
+    OPD_CARD_TRIPPED,
+    OPD_CARD_RESETTING,
+    OPD_CARD_LATCHED,
+} opd_card_state_t;
+
+/* Fault hook, tripped is false once the breaker of the card is closed again */
+typedef void (*opd_fault_cb_t)(i2caddr_t addr, bool tripped);
+
 typedef struct {
     uint8_t input;
     uint8_t odr;
@@ -51,11 +123,18 @@ typedef struct {
     uint8_t timeout;
 } opd_status_t;
 
+extern event_source_t opd_event;
+
 void opd_init(void);
+void opd_set_fault_cb(opd_fault_cb_t cb);
+void opd_discover(void);
+bool opd_probe(i2caddr_t addr);
+uint64_t opd_present(void);
 void opd_start(void);
 void opd_stop(void);
 void opd_enable(opd_addr_t opd_addr);
 void opd_disable(opd_addr_t opd_addr);
 void opd_reset(opd_addr_t opd_addr);
+void opd_batch(const opd_op_t *ops, size_t n);
 int  opd_status(opd_addr_t opd_addr, opd_status_t *status);
 #endif
@@ -8,10 +8,22 @@ extern "C" {
 #include "ch.h"
 #include "hal.h"
 #include "worker.h"
+#include "CANopen.h"
 
+/* Node ID from the OD, or from the LSS master if the app has an LSS server */
 #define ORESAT_DEFAULT_ID 0
 #define ORESAT_DEFAULT_BITRATE 1000
 
+/* Poll period of the LSS slave while waiting for a node ID */
+#ifndef ORESAT_LSS_POLL
+#define ORESAT_LSS_POLL TIME_MS2I(10)
+#endif
+
+/* Maximum number of OD access functions an app can register */
+#ifndef ORESAT_MAX_OD_FUNCS
+#define ORESAT_MAX_OD_FUNCS 8
+#endif
+
 extern event_source_t cos_event;
 
 typedef struct {
@@ -20,10 +32,15 @@ typedef struct {
     uint16_t bitrate;
 } oresat_config_t;
 
+typedef CO_SDO_abortCode_t (*od_func_t)(CO_ODF_arg_t *ODF_arg);
+
 /* OreSat initialization and main process */
 void oresat_init(void);
 void oresat_start(oresat_config_t *config);
 
+/* OD access functions, applied each time the CO stack is initialized */
+void reg_od_func(uint16_t index, od_func_t func, void *object);
+
 #ifdef __cplusplus
 }
 #endif /*__cplusplus*/
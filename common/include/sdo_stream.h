@@ -0,0 +1,33 @@
+#ifndef _SDO_STREAM_H_
+#define _SDO_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CANopen.h"
+
+/*
+ * Domain object backed by a source and/or a sink instead of RAM. The SDO
+ * server hands over one SDO buffer, one block of CO_SDO_BLOCK_SEGMENTS
+ * segments, per call, so the object size is independent of the buffer.
+ * The callbacks run from the SDO server with the OD locked and must not
+ * block.
+ */
+typedef struct {
+    /* Total size for uploads, 0 if not known up front */
+    uint32_t (*size)(void *arg);
+    /* Copy up to len bytes from offset into buf, returns the count, less than len at the end */
+    uint32_t (*read)(void *arg, uint32_t offset, uint8_t *buf, uint32_t len);
+    /* Take len bytes at offset, last is set on the final chunk, returns false to abort */
+    bool (*write)(void *arg, uint32_t offset, const uint8_t *buf, uint32_t len, bool last);
+    void *arg;
+} sdo_stream_t;
+
+/* OD function, register with the sdo_stream_t as the object */
+CO_SDO_abortCode_t sdo_stream_func(CO_ODF_arg_t *ODF_arg);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
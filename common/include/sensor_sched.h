@@ -0,0 +1,49 @@
+#ifndef _SENSOR_SCHED_H_
+#define _SENSOR_SCHED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/* Scheduler thread stack size */
+#ifndef SENSOR_SCHED_WA_SIZE
+#define SENSOR_SCHED_WA_SIZE    0x180
+#endif
+
+/* Scheduler thread priority */
+#ifndef SENSOR_SCHED_PRIO
+#define SENSOR_SCHED_PRIO       NORMALPRIO
+#endif
+
+/* Sensors due within this window of each other run in the same batch */
+#ifndef SENSOR_SCHED_COALESCE
+#define SENSOR_SCHED_COALESCE   TIME_MS2I(2)
+#endif
+
+/* Reads dev and stores the result in the OD target, false on failure */
+typedef bool (*sensor_acquire_t)(void *dev, void *od);
+
+typedef struct sensor {
+    void *bus;                  /* Sensors on the same bus run back to back, NULL if none */
+    sysinterval_t period;
+    sensor_acquire_t acquire;
+    void *dev;
+    void *od;                   /* OD target handed to acquire */
+    uint32_t errors;
+    systime_t next;             /* Deadline of the next acquisition */
+    bool due;
+    struct sensor *link;
+} sensor_t;
+
+/* OreSat sensor scheduler API */
+void init_sensor(sensor_t *sensor, void *bus, sysinterval_t period, sensor_acquire_t acquire, void *dev, void *od);
+void reg_sensor(sensor_t *sensor);
+void start_sensors(void);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
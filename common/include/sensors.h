@@ -5,6 +5,24 @@
 extern "C" {
 #endif
 
+/* Samples per channel in each half of the circular DMA buffer */
+#ifndef SENSORS_OVERSAMPLE
+#define SENSORS_OVERSAMPLE      32
+#endif
+
+/* Half buffers summed into one decimated output */
+#ifndef SENSORS_DECIMATION
+#define SENSORS_DECIMATION      64
+#endif
+
+/* Rate the decimated outputs are picked up and published at */
+#ifndef SENSORS_PERIOD
+#define SENSORS_PERIOD          TIME_MS2I(100)
+#endif
+
+/* Extra bits of resolution kept from oversampling */
+#define SENSORS_EXTRA_BITS      4
+
 #if defined(STM32F0xx_MCUCONF)
 #define TS_CAL1_BASE            ((uint32_t)0x1FFFF7B8)
 #define TS_CAL2_BASE            ((uint32_t)0x1FFFF7C2)
@@ -14,7 +32,7 @@ extern "C" {
 #define VREFINT_CAL_VOLT        330
 #define ADC_REG_CFG             ADC_CFGR1_CONT | ADC_CFGR1_RES_12BIT,               /* CFGR1    */  \
                                 ADC_TR(0, 0),                                       /* TR       */  \
-                                ADC_SMPR_SMP_55P5,                                  /* SMPR     */  \
+                                ADC_SMPR_SMP_239P5,                                 /* SMPR     */  \
                                 ADC_CHSELR_CHSEL16 | ADC_CHSELR_CHSEL17             /* CHSELR   */
 #define ADC_ENABLE_SENSORS(adc) {adcSTM32SetCCR(ADC_CCR_TSEN | ADC_CCR_VREFEN);}
 #elif defined(STM32F4xx_MCUCONF)
@@ -25,9 +43,9 @@ extern "C" {
 #define TS_CAL2_TEMP            110
 #define VREFINT_CAL_VOLT        330
 #define ADC_REG_CFG             0,                                                  /* CR1      */  \
-                                ADC_CR2_SWSTART,                                    /* CR2      */  \
-                                ADC_SMPR1_SMP_SENSOR(ADC_SAMPLE_144)                /* SMPR1    */  \
-                                | ADC_SMPR1_SMP_VREF(ADC_SAMPLE_144),                               \
+                                ADC_CR2_SWSTART | ADC_CR2_CONT,                     /* CR2      */  \
+                                ADC_SMPR1_SMP_SENSOR(ADC_SAMPLE_480)                /* SMPR1    */  \
+                                | ADC_SMPR1_SMP_VREF(ADC_SAMPLE_480),                               \
                                 0,                                                  /* SMPR2    */  \
                                 0,                                                  /* HTR      */  \
                                 0,                                                  /* LTR      */  \
@@ -48,8 +66,8 @@ extern "C" {
                                 ADC_TR(0, 4095),                                    /* TR1      */  \
                                 {                                                   /* SMPR[2]  */  \
                                     0,                                                              \
-                                    ADC_SMPR2_SMP_AN16(ADC_SMPR_SMP_47P5)                           \
-                                    | ADC_SMPR2_SMP_AN17(ADC_SMPR_SMP_47P5),                        \
+                                    ADC_SMPR2_SMP_AN16(ADC_SMPR_SMP_640P5)                          \
+                                    | ADC_SMPR2_SMP_AN17(ADC_SMPR_SMP_640P5),                       \
                                 },                                                                  \
                                 {                                                   /* SQR[4]   */  \
                                     ADC_SQR1_SQ1_N(ADC_CHANNEL_IN16)                                \
@@ -67,8 +85,17 @@ extern "C" {
 #define TS_CAL2                 (*((uint16_t*)TS_CAL2_BASE))
 #define VREFINT_CAL             (*((uint16_t*)VREFINT_CAL_BASE))
 
+/* One consistent set of calibrated MCU sensor values */
+typedef struct {
+    uint32_t seq;           /* Output number, 0 while being written */
+    uint16_t ts;            /* Raw temperature sensor, 12-bit */
+    uint16_t vrefint;       /* Raw VREFINT, 12-bit */
+    int16_t temperature;    /* 0.1 C */
+    int16_t voltage;        /* VDDA, 0.01 V */
+} sensors_snapshot_t;
+
 void sensors_init(void);
-void sensors_trig(void);
+bool sensors_get(sensors_snapshot_t *snap);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,331 @@
+/**
+ * @file    ltc2990.c
+ * @brief   LTC2990 Quad I2C Voltage, Current and Temperature Monitor.
+ *
+ * @addtogroup LTC2990
+ * @ingroup ORESAT
+ * @{
+ */
+
+#include "hal.h"
+#include "ltc2990.h"
+#include "i2c_bus.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define LTC2990_CH_BIT(ch)                  (1U << (ch))
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Channels holding a remote temperature, by control register mode.
+ * @note    TR1 results land in the V1 registers and TR2 in the V3 registers.
+ */
+static const uint8_t ltc2990_temp_ch[8] = {
+    LTC2990_CH_BIT(LTC2990_CH_V3),
+    LTC2990_CH_BIT(LTC2990_CH_V3),
+    0,
+    LTC2990_CH_BIT(LTC2990_CH_V1),
+    LTC2990_CH_BIT(LTC2990_CH_V1),
+    LTC2990_CH_BIT(LTC2990_CH_V1) | LTC2990_CH_BIT(LTC2990_CH_V3),
+    0,
+    0,
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+#if (LTC2990_USE_I2C) || defined(__DOXYGEN__)
+/**
+ * @brief   Reads registers value using I2C.
+ * @pre     The I2C interface must be initialized and the driver started.
+ *
+ * @param[in]  i2cp      pointer to the I2C interface
+ * @param[in]  sad       slave address without R bit
+ * @param[in]  reg       first sub-register address
+ * @param[out] rxbuf     pointer to an output buffer
+ * @param[in]  n         number of consecutive register to read
+ * @return               the operation status.
+ * @notapi
+ */
+static msg_t ltc2990I2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
+        uint8_t *rxbuf, size_t n) {
+    return i2c_bus_transmit(i2cp, sad, &reg, 1, rxbuf, n,
+            LTC2990_I2C_TIMEOUT);
+}
+
+/**
+ * @brief   Writes a value into a register using I2C.
+ * @pre     The I2C interface must be initialized and the driver started.
+ *
+ * @param[in] i2cp       pointer to the I2C interface
+ * @param[in] sad        slave address without R bit
+ * @param[in] reg        register address
+ * @param[in] value      register value
+ * @return               the operation status.
+ * @notapi
+ */
+static msg_t ltc2990I2CWriteRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
+        uint8_t value) {
+    uint8_t txbuf[2] = {reg, value};
+
+    return i2c_bus_transmit(i2cp, sad, txbuf, sizeof(txbuf), NULL, 0,
+            LTC2990_I2C_TIMEOUT);
+}
+#endif /* LTC2990_USE_I2C */
+
+/**
+ * @brief   Sign extends a result register pair.
+ *
+ * @param[in] msb        result MSB, flag bits included
+ * @param[in] lsb        result LSB
+ * @param[in] bits       width of the code
+ * @param[in] sign       the code is two's complement
+ * @return               the sign extended code.
+ * @notapi
+ */
+static int16_t ltc2990Extend(uint8_t msb, uint8_t lsb, unsigned int bits, bool sign) {
+    uint16_t code = ((msb << 8) | lsb) & ((1U << bits) - 1U);
+    uint16_t msk = sign ? 1U << (bits - 1U) : 0U;
+
+    return (int16_t)((code ^ msk) - msk);
+}
+
+/*==========================================================================*/
+/* Interface implementation.                                                */
+/*==========================================================================*/
+
+static const struct LTC2990VMT vmt_device = {
+    (size_t)0,
+};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] devp     pointer to the @p LTC2990Driver object
+ *
+ * @init
+ */
+void ltc2990ObjectInit(LTC2990Driver *devp) {
+    devp->vmt = &vmt_device;
+
+    devp->config = NULL;
+
+    devp->state = LTC2990_STOP;
+}
+
+/**
+ * @brief   Configures and activates LTC2990 Complex Driver peripheral.
+ * @details In repeated acquisition mode the first conversion is triggered
+ *          here and the device keeps converting on its own.
+ *
+ * @param[in] devp      pointer to the @p LTC2990Driver object
+ * @param[in] config    pointer to the @p LTC2990Config object
+ *
+ * @api
+ */
+void ltc2990Start(LTC2990Driver *devp, const LTC2990Config *config) {
+    osalDbgCheck((devp != NULL) && (config != NULL));
+    osalDbgAssert((devp->state == LTC2990_STOP) ||
+            (devp->state == LTC2990_READY),
+            "ltc2990Start(), invalid state");
+
+    devp->config = config;
+
+#if LTC2990_USE_I2C
+#if LTC2990_SHARED_I2C
+    i2cAcquireBus(config->i2cp);
+#endif /* LTC2990_SHARED_I2C */
+
+    i2cStart(config->i2cp, config->i2ccfg);
+    ltc2990I2CWriteRegister(config->i2cp, config->saddr, LTC2990_AD_CONTROL,
+            config->control);
+    if (!(config->control & LTC2990_CONTROL_SINGLE)) {
+        ltc2990I2CWriteRegister(config->i2cp, config->saddr, LTC2990_AD_TRIGGER, 0);
+    }
+
+#if LTC2990_SHARED_I2C
+    i2cReleaseBus(config->i2cp);
+#endif /* LTC2990_SHARED_I2C */
+#endif /* LTC2990_USE_I2C */
+    devp->state = LTC2990_READY;
+}
+
+/**
+ * @brief   Deactivates the LTC2990 Complex Driver peripheral.
+ * @details The device is left in single acquisition mode so it goes
+ *          idle after the conversion in progress.
+ *
+ * @param[in] devp       pointer to the @p LTC2990Driver object
+ *
+ * @api
+ */
+void ltc2990Stop(LTC2990Driver *devp) {
+    osalDbgCheck(devp != NULL);
+    osalDbgAssert((devp->state == LTC2990_STOP) || (devp->state == LTC2990_READY),
+            "ltc2990Stop(), invalid state");
+
+    if (devp->state == LTC2990_READY) {
+#if LTC2990_USE_I2C
+#if LTC2990_SHARED_I2C
+        i2cAcquireBus(devp->config->i2cp);
+        i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* LTC2990_SHARED_I2C */
+
+        ltc2990I2CWriteRegister(devp->config->i2cp, devp->config->saddr,
+                LTC2990_AD_CONTROL, devp->config->control | LTC2990_CONTROL_SINGLE);
+
+        i2cStop(devp->config->i2cp);
+#if LTC2990_SHARED_I2C
+        i2cReleaseBus(devp->config->i2cp);
+#endif /* LTC2990_SHARED_I2C */
+#endif /* LTC2990_USE_I2C */
+    }
+    devp->state = LTC2990_STOP;
+}
+
+/**
+ * @brief   Starts a conversion of the configured channels.
+ * @details Returns immediately, completion can be polled with
+ *          @p ltc2990ReadStatus() or taken from the data valid bits of
+ *          a later @p ltc2990ReadAll().
+ *
+ * @param[in] devp       pointer to the @p LTC2990Driver object
+ * @return               the operation status.
+ *
+ * @api
+ */
+msg_t ltc2990Trigger(LTC2990Driver *devp) {
+    msg_t ret = MSG_OK;
+
+    osalDbgCheck(devp != NULL);
+    osalDbgAssert(devp->state == LTC2990_READY,
+            "ltc2990Trigger(), invalid state");
+
+#if LTC2990_USE_I2C
+#if LTC2990_SHARED_I2C
+    i2cAcquireBus(devp->config->i2cp);
+    i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* LTC2990_SHARED_I2C */
+
+    ret = ltc2990I2CWriteRegister(devp->config->i2cp, devp->config->saddr,
+            LTC2990_AD_TRIGGER, 0);
+
+#if LTC2990_SHARED_I2C
+    i2cReleaseBus(devp->config->i2cp);
+#endif /* LTC2990_SHARED_I2C */
+#endif /* LTC2990_USE_I2C */
+    return ret;
+}
+
+/**
+ * @brief   Reads the LTC2990 status register.
+ *
+ * @param[in] devp       pointer to the @p LTC2990Driver object
+ * @param[out] status    the status register value
+ * @return               the operation status.
+ *
+ * @api
+ */
+msg_t ltc2990ReadStatus(LTC2990Driver *devp, uint8_t *status) {
+    msg_t ret = MSG_OK;
+
+    osalDbgCheck((devp != NULL) && (status != NULL));
+    osalDbgAssert(devp->state == LTC2990_READY,
+            "ltc2990ReadStatus(), invalid state");
+
+#if LTC2990_USE_I2C
+#if LTC2990_SHARED_I2C
+    i2cAcquireBus(devp->config->i2cp);
+    i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* LTC2990_SHARED_I2C */
+
+    ret = ltc2990I2CReadRegister(devp->config->i2cp, devp->config->saddr,
+            LTC2990_AD_STATUS, status, 1);
+
+#if LTC2990_SHARED_I2C
+    i2cReleaseBus(devp->config->i2cp);
+#endif /* LTC2990_SHARED_I2C */
+#endif /* LTC2990_USE_I2C */
+    return ret;
+}
+
+/**
+ * @brief   Reads all LTC2990 channels in one burst.
+ * @details Status and every result register are read in a single I2C
+ *          transaction, so all channels come from the same state of
+ *          the device. The data valid bit of each result is cleared by
+ *          the read, a channel is only flagged valid once per conversion.
+ *
+ * @param[in] devp       pointer to the @p LTC2990Driver object
+ * @param[out] data      decoded channels
+ * @return               the operation status.
+ *
+ * @api
+ */
+msg_t ltc2990ReadAll(LTC2990Driver *devp, ltc2990_data_t *data) {
+    uint8_t buf[LTC2990_NUM_REGS];
+    uint8_t temp_ch, mode;
+    bool kelvin;
+    msg_t ret = MSG_OK;
+
+    osalDbgCheck((devp != NULL) && (data != NULL));
+    osalDbgAssert(devp->state == LTC2990_READY,
+            "ltc2990ReadAll(), invalid state");
+
+#if LTC2990_USE_I2C
+#if LTC2990_SHARED_I2C
+    i2cAcquireBus(devp->config->i2cp);
+    i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* LTC2990_SHARED_I2C */
+
+    ret = ltc2990I2CReadRegister(devp->config->i2cp, devp->config->saddr,
+            LTC2990_AD_STATUS, buf, sizeof(buf));
+
+#if LTC2990_SHARED_I2C
+    i2cReleaseBus(devp->config->i2cp);
+#endif /* LTC2990_SHARED_I2C */
+#endif /* LTC2990_USE_I2C */
+    if (ret != MSG_OK)
+        return ret;
+
+    mode = (buf[LTC2990_AD_CONTROL] & LTC2990_CONTROL_MODE) >> LTC2990_CONTROL_MODE_Pos;
+    temp_ch = ltc2990_temp_ch[mode] | LTC2990_CH_BIT(LTC2990_CH_TINT);
+    kelvin = buf[LTC2990_AD_CONTROL] & LTC2990_CONTROL_KELVIN;
+
+    data->status = buf[LTC2990_AD_STATUS];
+    data->valid = 0;
+    data->fault = 0;
+    for (unsigned int ch = 0; ch < LTC2990_NUM_CH; ch++) {
+        uint8_t msb = buf[LTC2990_AD_TINT_MSB + 2 * ch];
+        uint8_t lsb = buf[LTC2990_AD_TINT_LSB + 2 * ch];
+
+        if (msb & LTC2990_MSB_DV)
+            data->valid |= LTC2990_CH_BIT(ch);
+        if (temp_ch & LTC2990_CH_BIT(ch)) {
+            if ((ch != LTC2990_CH_TINT) && (msb & (LTC2990_MSB_SS | LTC2990_MSB_SO)))
+                data->fault |= LTC2990_CH_BIT(ch);
+            /* Kelvin results are unsigned */
+            data->raw[ch] = ltc2990Extend(msb, lsb, 13, !kelvin);
+        } else {
+            data->raw[ch] = ltc2990Extend(msb, lsb, 15, true);
+        }
+    }
+
+    return MSG_OK;
+}
+
+/** @} */
@@ -0,0 +1,12 @@
+# Required libraries for the LTC2990
+include $(PROJ_SRC)/i2c_bus.mk
+
+# List of all the LTC2990 device files.
+LTC2990SRC := $(PROJ_SRC)/ltc2990.c
+
+# Required include directories
+LTC2990INC := $(PROJ_SRC)/include
+
+# Shared variables
+ALLCSRC += $(LTC2990SRC)
+ALLINC  += $(LTC2990INC)
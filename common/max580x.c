@@ -9,6 +9,7 @@
 
 #include "hal.h"
 #include "max580x.h"
+#include "i2c_bus.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -51,8 +52,8 @@ typedef union {
  */
 msg_t max580xI2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
         uint8_t* rxbuf, size_t n) {
-    return i2cMasterTransmitTimeout(i2cp, sad, &reg, 1, rxbuf, n,
-            TIME_INFINITE);
+    return i2c_bus_transmit(i2cp, sad, &reg, 1, rxbuf, n,
+            MAX580X_I2C_TIMEOUT);
 }
 
 /**
@@ -69,8 +70,8 @@ msg_t max580xI2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
  */
 msg_t max580xI2CWriteRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t *txbuf,
         size_t n) {
-    return i2cMasterTransmitTimeout(i2cp, sad, txbuf, n, NULL, 0,
-            TIME_INFINITE);
+    return i2c_bus_transmit(i2cp, sad, txbuf, n, NULL, 0,
+            MAX580X_I2C_TIMEOUT);
 }
 #endif /* MAX580X_USE_I2C */
 
@@ -98,6 +99,9 @@ void max580xObjectInit(MAX580XDriver *devp) {
 
     devp->config = NULL;
 
+    devp->code = MAX580X_CODE_UNKNOWN;
+    devp->dac = MAX580X_CODE_UNKNOWN;
+
     devp->state = MAX580X_STOP;
 }
 
@@ -118,6 +122,8 @@ void max580xStart(MAX580XDriver *devp, const MAX580XConfig *config) {
             "max580xStart(), invalid state");
 
     devp->config = config;
+    devp->code = MAX580X_CODE_UNKNOWN;
+    devp->dac = MAX580X_CODE_UNKNOWN;
     buf.value = 0;
 
     /* Configuring common registers.*/
@@ -240,20 +246,36 @@ uint16_t max580xReadRaw(MAX580XDriver *devp, max580x_reg_t reg) {
 
 /**
  * @brief   Writes MAX580X DAC Register as raw value.
+ * @note    Writes that would not change the cached CODE and DAC
+ *          contents are skipped. A failed write marks the cached
+ *          contents unknown, so the next write goes out.
  *
  * @param[in] devp       pointer to the @p MAX580XDriver object
  * @param[in] reg        the DAC register to write the value into
  * @param[in] value      the value to write to a DAC register
+ * @return               the operation status.
  *
  * @api
  */
-void max580xWriteRaw(MAX580XDriver *devp, max580x_reg_t reg, uint16_t value) {
+msg_t max580xWriteRaw(MAX580XDriver *devp, max580x_reg_t reg, uint16_t value) {
     i2cbuf_t buf;
+    msg_t ret = MSG_OK;
 
     osalDbgCheck(devp != NULL);
     osalDbgAssert(devp->state == MAX580X_READY,
             "max580xWriteRaw(), invalid state");
 
+    if (reg == MAX580X_CODE) {
+        if (value == devp->code)
+            return MSG_OK;
+    } else if (reg == MAX580X_CODE_LOAD) {
+        if (value == devp->code && value == devp->dac)
+            return MSG_OK;
+    } else if (reg == MAX580X_LOAD) {
+        if (devp->code == devp->dac && devp->code != MAX580X_CODE_UNKNOWN)
+            return MSG_OK;
+    }
+
 #if MAX580X_USE_I2C
 #if MAX580X_SHARED_I2C
     i2cAcquireBus(devp->config->i2cp);
@@ -262,12 +284,23 @@ void max580xWriteRaw(MAX580XDriver *devp, max580x_reg_t reg, uint16_t value) {
 
     buf.reg = reg;
     buf.value = MAX580X_VAL2DAC(value, devp->res);
-    max580xI2CWriteRegister(devp->config->i2cp, devp->config->saddr, buf.buf, sizeof(buf));
+    ret = max580xI2CWriteRegister(devp->config->i2cp, devp->config->saddr, buf.buf, sizeof(buf));
 
 #if MAX580X_SHARED_I2C
     i2cReleaseBus(devp->config->i2cp);
 #endif /* MAX580X_SHARED_I2C */
 #endif /* MAX580X_USE_I2C */
+    (void)buf;
+
+    if (reg == MAX580X_CODE) {
+        devp->code = (ret == MSG_OK) ? value : MAX580X_CODE_UNKNOWN;
+    } else if (reg == MAX580X_CODE_LOAD) {
+        devp->code = (ret == MSG_OK) ? value : MAX580X_CODE_UNKNOWN;
+        devp->dac = devp->code;
+    } else if (reg == MAX580X_LOAD) {
+        devp->dac = (ret == MSG_OK) ? devp->code : MAX580X_CODE_UNKNOWN;
+    }
+    return ret;
 }
 
 /**
@@ -305,20 +338,15 @@ uint32_t max580xReadVoltage(MAX580XDriver *devp, max580x_reg_t reg) {
 }
 
 /**
- * @brief   Writes MAX580X DAC Register as a voltage.
- * @details This only works when using an internal reference and assumes sufficient supply.
+ * @brief   Converts a voltage into a DAC code.
  *
  * @param[in] devp       pointer to the @p MAX580XDriver object
- * @param[in] reg        the DAC register to write the value into
- * @param[in] voltage    the voltage to write to a DAC register
+ * @param[in] voltage    the voltage to convert
+ * @return               the DAC code.
  *
- * @api
+ * @notapi
  */
-void max580xWriteVoltage(MAX580XDriver *devp, max580x_reg_t reg, uint32_t voltage) {
-    osalDbgCheck(devp != NULL);
-    osalDbgAssert(devp->config->ref != MAX580X_REF_EXT,
-            "max580xWriteVoltage(), REF_EXT not allowed");
-
+static uint16_t max580xVoltageToCode(MAX580XDriver *devp, uint32_t voltage) {
     /* TODO: Clean this up, it's terrible */
     /* TODO: Bounds checking */
     voltage -= (voltage % 5);
@@ -334,21 +362,43 @@ void max580xWriteVoltage(MAX580XDriver *devp, max580x_reg_t reg, uint32_t voltag
             voltage /= 40960;
             break;
     }
-    max580xWriteRaw(devp, reg, voltage);
+    return voltage;
+}
+
+/**
+ * @brief   Writes MAX580X DAC Register as a voltage.
+ * @details This only works when using an internal reference and assumes sufficient supply.
+ *
+ * @param[in] devp       pointer to the @p MAX580XDriver object
+ * @param[in] reg        the DAC register to write the value into
+ * @param[in] voltage    the voltage to write to a DAC register
+ * @return               the operation status.
+ *
+ * @api
+ */
+msg_t max580xWriteVoltage(MAX580XDriver *devp, max580x_reg_t reg, uint32_t voltage) {
+    osalDbgCheck(devp != NULL);
+    osalDbgAssert(devp->config->ref != MAX580X_REF_EXT,
+            "max580xWriteVoltage(), REF_EXT not allowed");
+
+    return max580xWriteRaw(devp, reg, max580xVoltageToCode(devp, voltage));
 }
 
 /**
  * @brief   Execute MAX580X LOAD instruction.
  *
  * @param[in] devp       pointer to the @p MAX580XDriver object
+ * @return               the operation status.
  *
  * @api
  */
-void max580xLoad(MAX580XDriver *devp) {
+msg_t max580xLoad(MAX580XDriver *devp) {
     i2cbuf_t buf;
+    msg_t ret = MSG_OK;
+
     osalDbgCheck(devp != NULL);
     osalDbgAssert(devp->state == MAX580X_READY,
-            "max580xReadRaw(), invalid state");
+            "max580xLoad(), invalid state");
 
 #if MAX580X_USE_I2C
 #if MAX580X_SHARED_I2C
@@ -358,12 +408,98 @@ void max580xLoad(MAX580XDriver *devp) {
 
     buf.reg = MAX580X_AD_LOAD;
     buf.value = 0;
-    max580xI2CWriteRegister(devp->config->i2cp, devp->config->saddr, buf.buf, sizeof(buf));
+    ret = max580xI2CWriteRegister(devp->config->i2cp, devp->config->saddr, buf.buf, sizeof(buf));
 
 #if MAX580X_SHARED_I2C
     i2cReleaseBus(devp->config->i2cp);
 #endif /* MAX580X_SHARED_I2C */
 #endif /* MAX580X_USE_I2C */
+    (void)buf;
+    devp->dac = (ret == MSG_OK) ? devp->code : MAX580X_CODE_UNKNOWN;
+    return ret;
+}
+
+/**
+ * @brief   Stages a raw value in the MAX580X CODE register.
+ * @details The output does not change until @p max580xCommit() is called.
+ *          Nothing is written if the CODE register already holds @p value.
+ *
+ * @param[in] devp       pointer to the @p MAX580XDriver object
+ * @param[in] value      the value to stage
+ *
+ * @api
+ */
+void max580xStageRaw(MAX580XDriver *devp, uint16_t value) {
+    max580xWriteRaw(devp, MAX580X_CODE, value);
+}
+
+/**
+ * @brief   Stages a voltage in the MAX580X CODE register.
+ * @details This only works when using an internal reference and assumes sufficient supply.
+ *
+ * @param[in] devp       pointer to the @p MAX580XDriver object
+ * @param[in] voltage    the voltage to stage
+ *
+ * @api
+ */
+void max580xStageVoltage(MAX580XDriver *devp, uint32_t voltage) {
+    max580xWriteVoltage(devp, MAX580X_CODE, voltage);
+}
+
+/**
+ * @brief   Loads the staged CODE values of several MAX580X devices.
+ * @details Devices whose output already matches the staged code are
+ *          skipped. Consecutive devices on the same bus are loaded
+ *          back to back under a single bus acquisition.
+ *
+ * @param[in] devs       array of pointers to @p MAX580XDriver objects
+ * @param[in] n          number of devices in @p devs
+ *
+ * @api
+ */
+void max580xCommit(MAX580XDriver *devs[], size_t n) {
+    i2cbuf_t buf;
+    msg_t ret = MSG_OK;
+#if MAX580X_USE_I2C
+    I2CDriver *i2cp = NULL;
+#endif /* MAX580X_USE_I2C */
+
+    osalDbgCheck((devs != NULL) || (n == 0U));
+
+    for (size_t i = 0; i < n; i++) {
+        MAX580XDriver *devp = devs[i];
+
+        osalDbgCheck(devp != NULL);
+        osalDbgAssert(devp->state == MAX580X_READY,
+                "max580xCommit(), invalid state");
+
+        if (devp->code == devp->dac || devp->code == MAX580X_CODE_UNKNOWN)
+            continue;
+
+#if MAX580X_USE_I2C
+        if (devp->config->i2cp != i2cp) {
+#if MAX580X_SHARED_I2C
+            if (i2cp != NULL)
+                i2cReleaseBus(i2cp);
+            i2cAcquireBus(devp->config->i2cp);
+            i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* MAX580X_SHARED_I2C */
+            i2cp = devp->config->i2cp;
+        }
+
+        buf.reg = MAX580X_AD_LOAD;
+        buf.value = 0;
+        ret = max580xI2CWriteRegister(i2cp, devp->config->saddr, buf.buf, sizeof(buf));
+#endif /* MAX580X_USE_I2C */
+        /* A failed load is retried by the next commit */
+        devp->dac = (ret == MSG_OK) ? devp->code : MAX580X_CODE_UNKNOWN;
+    }
+
+#if MAX580X_USE_I2C && MAX580X_SHARED_I2C
+    if (i2cp != NULL)
+        i2cReleaseBus(i2cp);
+#endif /* MAX580X_USE_I2C && MAX580X_SHARED_I2C */
+    (void)buf;
 }
 
 /** @} */
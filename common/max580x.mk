@@ -1,3 +1,6 @@
+# Required libraries for the MAX580X
+include $(PROJ_SRC)/i2c_bus.mk
+
 # List of all the MAX580X device files.
 MAX580XSRC := $(PROJ_SRC)/max580x.c
 
@@ -9,6 +9,7 @@
 
 #include "hal.h"
 #include "max7310.h"
+#include "i2c_bus.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -48,8 +49,8 @@ typedef union {
  */
 msg_t max7310I2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
         uint8_t* rxbuf, size_t n) {
-    return i2cMasterTransmitTimeout(i2cp, sad, &reg, 1, rxbuf, n,
-            TIME_INFINITE);
+    return i2c_bus_transmit(i2cp, sad, &reg, 1, rxbuf, n,
+            MAX7310_I2C_TIMEOUT);
 }
 
 /**
@@ -66,8 +67,8 @@ msg_t max7310I2CReadRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t reg,
  */
 msg_t max7310I2CWriteRegister(I2CDriver *i2cp, i2caddr_t sad, uint8_t *txbuf,
         size_t n) {
-    return i2cMasterTransmitTimeout(i2cp, sad, txbuf, n, NULL, 0,
-            TIME_INFINITE);
+    return i2c_bus_transmit(i2cp, sad, txbuf, n, NULL, 0,
+            MAX7310_I2C_TIMEOUT);
 }
 #endif /* MAX7310_USE_I2C */
 
@@ -233,6 +234,42 @@ uint8_t max7310ReadRaw(MAX7310Driver *devp, uint8_t reg) {
     return value;
 }
 
+/**
+ * @brief   Reads consecutive MAX7310 registers in a single transaction.
+ * @details The register pointer auto-increments, so a snapshot of the
+ *          whole register file costs one bus transaction.
+ *
+ * @param[in] devp       pointer to the @p MAX7310Driver object
+ * @param[in] reg        the first register to read
+ * @param[out] buf       pointer to the output buffer
+ * @param[in] n          number of registers to read
+ * @return               the operation status.
+ *
+ * @api
+ */
+msg_t max7310ReadBurst(MAX7310Driver *devp, uint8_t reg, uint8_t *buf, size_t n) {
+    msg_t ret = MSG_OK;
+
+    osalDbgCheck((devp != NULL) && (buf != NULL) && (n > 0U));
+
+    osalDbgAssert(devp->state == MAX7310_READY,
+            "max7310ReadBurst(), invalid state");
+
+#if MAX7310_USE_I2C
+#if MAX7310_SHARED_I2C
+    i2cAcquireBus(devp->config->i2cp);
+    i2cStart(devp->config->i2cp, devp->config->i2ccfg);
+#endif /* MAX7310_SHARED_I2C */
+
+    ret = max7310I2CReadRegister(devp->config->i2cp, devp->config->saddr, reg, buf, n);
+
+#if MAX7310_SHARED_I2C
+    i2cReleaseBus(devp->config->i2cp);
+#endif /* MAX7310_SHARED_I2C */
+#endif /* MAX7310_USE_I2C */
+    return ret;
+}
+
 /**
  * @brief   Writes MAX7310 register as raw value.
  *
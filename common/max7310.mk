@@ -1,3 +1,6 @@
+# Required libraries for the MAX7310
+include $(PROJ_SRC)/i2c_bus.mk
+
 # List of all the MAX7310 device files.
 MAX7310SRC := $(PROJ_SRC)/max7310.c
 
@@ -1,15 +1,31 @@
 #include "hal.h"
 #include "max7310.h"
 #include "opd.h"
+#include "i2c_bus.h"
 
 #define OPD_ADDR_MAX        (MAX7310_MAX_ADDR + 1)
+#define OPD_ADDR_BIT(addr)  (((uint64_t)1U) << (addr))
+#define OPD_WAKE_EVENT      EVENT_MASK(0)
 
 static struct {
     MAX7310Driver dev;
     MAX7310Config config;
+    uint8_t odr;
     bool valid;
+    opd_card_state_t state;
+    uint8_t retries;
+    systime_t since;
+    sysinterval_t wait;
 } opd_dev[OPD_ADDR_MAX];
 
+EVENTSOURCE_DECL(opd_event);
+static MUTEX_DECL(opd_mtx);
+static THD_WORKING_AREA(opd_wa, OPD_MONITOR_WA_SIZE);
+static thread_t *opd_tp = NULL;
+static bool opd_started = false;
+static uint64_t opd_present_map = 0;
+static opd_fault_cb_t opd_fault_cb = NULL;
+
 static const I2CConfig i2cconfig = {
     OPMODE_I2C,
     100000,
@@ -26,17 +42,173 @@ static MAX7310Config defconfig = {
     MAX7310_TIMEOUT_ENABLED
 };
 
-void opd_discover(void)
+bool opd_probe(i2caddr_t addr)
 {
     uint8_t temp;
+    msg_t ret;
+
     i2cAcquireBus(&I2CD1);
-    for (i2caddr_t i = MAX7310_MIN_ADDR; i <= MAX7310_MAX_ADDR; i++) {
-        if (i2cMasterReceiveTimeout(&I2CD1, i, &temp, 1, TIME_MS2I(10)) == MSG_OK)
-            opd_dev[i].valid = true;
-        else
-            opd_dev[i].valid = false;
+    ret = i2cMasterReceiveTimeout(&I2CD1, addr, &temp, 1, OPD_PROBE_TIMEOUT);
+    if (ret == MSG_TIMEOUT) {
+        /* A timed out transfer leaves the driver locked */
+        i2c_bus_recover(&I2CD1);
     }
     i2cReleaseBus(&I2CD1);
+    return ret == MSG_OK;
+}
+
+static eventflags_t opd_update(i2caddr_t addr, bool present)
+{
+    eventflags_t flags = 0;
+
+    chMtxLock(&opd_mtx);
+    if (present && !opd_dev[addr].valid) {
+        if (opd_started) {
+            max7310Start(&opd_dev[addr].dev, &opd_dev[addr].config);
+            opd_dev[addr].odr = opd_dev[addr].config.odr;
+        }
+        opd_dev[addr].state = OPD_CARD_OK;
+        opd_dev[addr].retries = 0;
+        opd_present_map |= OPD_ADDR_BIT(addr);
+        flags = OPD_EVENT_INSERT;
+    } else if (!present && opd_dev[addr].valid) {
+        /* Device is gone, drop driver state without touching the bus */
+        max7310ObjectInit(&opd_dev[addr].dev);
+        if (opd_dev[addr].state != OPD_CARD_OK && opd_fault_cb != NULL)
+            opd_fault_cb(addr, false);
+        opd_present_map &= ~OPD_ADDR_BIT(addr);
+        flags = OPD_EVENT_REMOVE;
+    }
+    opd_dev[addr].valid = present;
+    chMtxUnlock(&opd_mtx);
+    return flags;
+}
+
+void opd_discover(void)
+{
+    eventflags_t flags = 0;
+
+    /* The bus is released between probes so other users are not starved */
+    for (i2caddr_t i = MAX7310_MIN_ADDR; i <= MAX7310_MAX_ADDR; i++) {
+        flags |= opd_update(i, opd_probe(i));
+    }
+    if (flags)
+        chEvtBroadcastFlags(&opd_event, flags);
+}
+
+uint64_t opd_present(void)
+{
+    return opd_present_map;
+}
+
+static void opd_pulse(i2caddr_t addr)
+{
+    /* CB_RESET is released by the monitor once the pulse time has passed */
+    max7310WriteRaw(&opd_dev[addr].dev, MAX7310_AD_ODR,
+            opd_dev[addr].odr | MAX7310_PIN_MASK(OPD_CB_RESET));
+    opd_dev[addr].state = OPD_CARD_RESETTING;
+    opd_dev[addr].since = chVTGetSystemTime();
+    opd_dev[addr].wait = TIME_MS2I(OPD_RESET_PULSE);
+}
+
+static void opd_trip(i2caddr_t addr)
+{
+    systime_t now = chVTGetSystemTime();
+
+    opd_dev[addr].since = now;
+    if (opd_dev[addr].retries >= OPD_RESET_RETRIES) {
+        /* Give up until the card is reset by hand */
+        opd_dev[addr].state = OPD_CARD_LATCHED;
+    } else {
+        opd_dev[addr].state = OPD_CARD_TRIPPED;
+        opd_dev[addr].wait = TIME_MS2I(OPD_RESET_BACKOFF << opd_dev[addr].retries);
+    }
+    if (opd_fault_cb != NULL)
+        opd_fault_cb(addr, true);
+}
+
+static eventflags_t opd_service(i2caddr_t addr)
+{
+    uint8_t input;
+    bool elapsed;
+
+    if (!opd_dev[addr].valid || !opd_started)
+        return 0;
+
+    elapsed = chVTTimeElapsedSinceX(opd_dev[addr].since) >= opd_dev[addr].wait;
+    switch (opd_dev[addr].state) {
+    case OPD_CARD_RESETTING:
+        if (elapsed) {
+            max7310WriteRaw(&opd_dev[addr].dev, MAX7310_AD_ODR, opd_dev[addr].odr);
+            opd_dev[addr].state = OPD_CARD_OK;
+            opd_dev[addr].since = chVTGetSystemTime();
+            opd_dev[addr].wait = TIME_MS2I(OPD_FAULT_CLEAR_TIME);
+            if (opd_fault_cb != NULL)
+                opd_fault_cb(addr, false);
+        }
+        return 0;
+    case OPD_CARD_TRIPPED:
+        if (elapsed) {
+            opd_dev[addr].retries++;
+            opd_pulse(addr);
+        }
+        return 0;
+    default:
+        break;
+    }
+
+    if (max7310ReadBurst(&opd_dev[addr].dev, MAX7310_AD_INPUT, &input, 1) != MSG_OK)
+        return 0;
+
+    if (input & MAX7310_PIN_MASK(OPD_FAULT)) {
+        if (opd_dev[addr].state == OPD_CARD_OK) {
+            opd_trip(addr);
+            return OPD_EVENT_TRIP;
+        }
+    } else if (opd_dev[addr].state == OPD_CARD_OK && opd_dev[addr].retries && elapsed) {
+        /* Card has stayed healthy long enough, forget earlier retries */
+        opd_dev[addr].retries = 0;
+    }
+    return 0;
+}
+
+static THD_FUNCTION(opd_monitor, arg)
+{
+    systime_t last_scan;
+    eventflags_t flags;
+    (void)arg;
+    chRegSetThreadName("OPD Monitor");
+
+    last_scan = chVTGetSystemTime();
+    while (!chThdShouldTerminateX()) {
+        chEvtWaitAnyTimeout(OPD_WAKE_EVENT, TIME_MS2I(OPD_FAULT_POLL_INTERVAL));
+        if (chVTTimeElapsedSinceX(last_scan) >= TIME_MS2I(OPD_RESCAN_INTERVAL)) {
+            last_scan = chVTGetSystemTime();
+            opd_discover();
+        }
+
+        flags = 0;
+        for (i2caddr_t i = MAX7310_MIN_ADDR; i <= MAX7310_MAX_ADDR; i++) {
+            chMtxLock(&opd_mtx);
+            flags |= opd_service(i);
+            chMtxUnlock(&opd_mtx);
+        }
+        if (flags)
+            chEvtBroadcastFlags(&opd_event, flags);
+    }
+    chThdExit(MSG_OK);
+}
+
+/*
+ * Set the fault hook, called with the OPD lock held when a card trips and
+ * when its breaker is closed again or the card is removed. It must not call
+ * back into the OPD driver.
+ */
+void opd_set_fault_cb(opd_fault_cb_t cb)
+{
+    chMtxLock(&opd_mtx);
+    opd_fault_cb = cb;
+    chMtxUnlock(&opd_mtx);
 }
 
 void opd_init(void)
@@ -45,66 +217,120 @@ void opd_init(void)
         max7310ObjectInit(&opd_dev[i].dev);
         opd_dev[i].config = defconfig;
         opd_dev[i].config.saddr = i;
+        opd_dev[i].valid = false;
     }
+    opd_present_map = 0;
     i2cStart(&I2CD1, &i2cconfig);
     opd_discover();
 }
 
 void opd_start(void)
 {
+    chMtxLock(&opd_mtx);
     for (i2caddr_t i = MAX7310_MIN_ADDR; i <= MAX7310_MAX_ADDR; i++) {
-        if (opd_dev[i].valid)
+        if (opd_dev[i].valid) {
             max7310Start(&opd_dev[i].dev, &opd_dev[i].config);
+            opd_dev[i].odr = opd_dev[i].config.odr;
+        }
     }
+    opd_started = true;
+    chMtxUnlock(&opd_mtx);
+
+    if (opd_tp == NULL)
+        opd_tp = chThdCreateStatic(opd_wa, sizeof(opd_wa), OPD_MONITOR_PRIO, opd_monitor, NULL);
 }
 
 void opd_stop(void)
 {
+    if (opd_tp != NULL) {
+        chThdTerminate(opd_tp);
+        chEvtSignal(opd_tp, OPD_WAKE_EVENT);
+        chThdWait(opd_tp);
+        opd_tp = NULL;
+    }
+
+    chMtxLock(&opd_mtx);
     for (i2caddr_t i = MAX7310_MIN_ADDR; i <= MAX7310_MAX_ADDR; i++) {
         max7310Stop(&opd_dev[i].dev);
     }
+    opd_started = false;
+    chMtxUnlock(&opd_mtx);
     i2cStop(&I2CD1);
 }
 
-void opd_enable(opd_addr_t opd_addr)
+void opd_batch(const opd_op_t *ops, size_t n)
 {
-    if (opd_dev[opd_addr].valid != true)
+    bool reset = false;
+
+    chMtxLock(&opd_mtx);
+    if (!opd_started) {
+        chMtxUnlock(&opd_mtx);
         return;
-    uint8_t regval;
-    regval = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR);
-    regval |= MAX7310_PIN_MASK(OPD_LED);
-    max7310WriteRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR, regval);
+    }
+    /* Output states come from the shadow register, so no reads are needed */
+    for (size_t i = 0; i < n; i++) {
+        opd_addr_t addr = ops[i].addr;
+        if (addr >= OPD_ADDR_MAX || opd_dev[addr].valid != true)
+            continue;
+        uint8_t regval = opd_dev[addr].odr;
+        if (ops[i].ops & OPD_OP_ENABLE)
+            regval |= MAX7310_PIN_MASK(OPD_LED);
+        if (ops[i].ops & OPD_OP_DISABLE)
+            regval &= ~MAX7310_PIN_MASK(OPD_LED);
+        opd_dev[addr].odr = regval;
+        if (ops[i].ops & OPD_OP_RESET) {
+            /* A manual reset also clears the retry count and any latch */
+            opd_dev[addr].retries = 0;
+            opd_pulse(addr);
+            reset = true;
+        } else if (opd_dev[addr].state != OPD_CARD_RESETTING) {
+            max7310WriteRaw(&opd_dev[addr].dev, MAX7310_AD_ODR, regval);
+        }
+    }
+    chMtxUnlock(&opd_mtx);
+
+    /* The monitor releases the reset pulses, the caller does not wait */
+    if (reset && opd_tp != NULL)
+        chEvtSignal(opd_tp, OPD_WAKE_EVENT);
+}
+
+void opd_enable(opd_addr_t opd_addr)
+{
+    opd_op_t op = {opd_addr, OPD_OP_ENABLE};
+    opd_batch(&op, 1);
 }
 
 void opd_disable(opd_addr_t opd_addr)
 {
-    if (opd_dev[opd_addr].valid != true)
-        return;
-    uint8_t regval;
-    regval = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR);
-    regval &= ~MAX7310_PIN_MASK(OPD_LED);
-    max7310WriteRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR, regval);
+    opd_op_t op = {opd_addr, OPD_OP_DISABLE};
+    opd_batch(&op, 1);
 }
 
 void opd_reset(opd_addr_t opd_addr)
 {
-    uint8_t regval;
-    regval = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR);
-    regval |= MAX7310_PIN_MASK(OPD_CB_RESET);
-    max7310WriteRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR, regval);
-    chThdSleepMilliseconds(10);
-    regval &= ~MAX7310_PIN_MASK(OPD_CB_RESET);
-    max7310WriteRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR, regval);
+    opd_op_t op = {opd_addr, OPD_OP_RESET};
+    opd_batch(&op, 1);
 }
 
 int opd_status(opd_addr_t opd_addr, opd_status_t *status)
 {
-    if (opd_dev[opd_addr].valid != true)
+    uint8_t regs[MAX7310_NUM_REGS];
+    msg_t ret;
+
+    chMtxLock(&opd_mtx);
+    if (opd_dev[opd_addr].valid != true) {
+        chMtxUnlock(&opd_mtx);
         return -1;
-    status->input = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_INPUT);
-    status->odr = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_ODR);
-    status->pol = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_POL);
-    status->mode = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_MODE);
-    status->timeout = max7310ReadRaw(&opd_dev[opd_addr].dev, MAX7310_AD_TIMEOUT);
+    }
+    ret = max7310ReadBurst(&opd_dev[opd_addr].dev, MAX7310_AD_INPUT, regs, sizeof(regs));
+    chMtxUnlock(&opd_mtx);
+    if (ret != MSG_OK)
+        return -1;
+
+    status->input = regs[MAX7310_AD_INPUT];
+    status->odr = regs[MAX7310_AD_ODR];
+    status->pol = regs[MAX7310_AD_POL];
+    status->mode = regs[MAX7310_AD_MODE];
+    status->timeout = regs[MAX7310_AD_TIMEOUT];
     return 0;
 }
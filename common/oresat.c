@@ -1,6 +1,8 @@
 #include "oresat.h"
 #include "events.h"
 #include "sensors.h"
+#include "sensor_sched.h"
+#include "crc16.h"
 #include "CANopen.h"
 
 typedef enum {
@@ -10,9 +12,17 @@ typedef enum {
     ORESAT_NMT_OPERATIONAL,
 } oresat_eventid_t;
 
+typedef struct {
+    uint16_t index;
+    od_func_t func;
+    void *object;
+} od_func_reg_t;
+
 EVENTSOURCE_DECL(cos_event);
 static thread_t *oresat_tp;
 evreg_t event_registry;
+static od_func_reg_t od_funcs[ORESAT_MAX_OD_FUNCS];
+static unsigned int od_func_count;
 
 void CO_NMT_cb(CO_NMT_internalState_t state)
 {
@@ -35,6 +45,58 @@ void nmt_handler(eventid_t eventid)
     }
 }
 
+void reg_od_func(uint16_t index, od_func_t func, void *object)
+{
+    chDbgAssert(od_func_count < ORESAT_MAX_OD_FUNCS, "reg_od_func(): table full");
+
+    if (od_func_count < ORESAT_MAX_OD_FUNCS) {
+        od_funcs[od_func_count].index = index;
+        od_funcs[od_func_count].func = func;
+        od_funcs[od_func_count].object = object;
+        od_func_count++;
+    }
+}
+
+#if CO_NO_LSS_SERVER == 1
+/*
+ * Bring up CAN and the LSS slave only, and if the node has no ID yet wait
+ * for the LSS master to assign one. The ID is taken once the master
+ * releases the node, and is kept in OD_CANNodeID across communication
+ * resets.
+ */
+static CO_ReturnError_t oresat_lss_init(CANDriver *cand)
+{
+    uint8_t node_id = OD_CANNodeID;
+    uint16_t bitrate = OD_CANBitRate;
+    event_listener_t can_el;
+    CO_ReturnError_t err;
+
+    err = CO_new();
+    if (err == CO_ERROR_NO)
+        err = CO_CANinit(cand, OD_CANBitRate);
+    if (err == CO_ERROR_NO)
+        err = CO_LSSinit(OD_CANNodeID, OD_CANBitRate);
+    if (err != CO_ERROR_NO)
+        return err;
+
+    if (OD_CANNodeID == CO_LSS_NODE_ID_ASSIGNMENT) {
+        CO_CANsetNormalMode(CO->CANmodule[0]);
+        chEvtRegister(&CO->CANmodule[0]->rx_event, &can_el, ORESAT_RX_EVENT);
+        while (node_id == CO_LSS_NODE_ID_ASSIGNMENT || CO->LSSslave->lssState != CO_LSS_STATE_WAITING) {
+            chEvtWaitAnyTimeout(EVENT_MASK(ORESAT_RX_EVENT), ORESAT_LSS_POLL);
+            CO_LSSslave_process(CO->LSSslave, OD_CANBitRate, OD_CANNodeID, &bitrate, &node_id);
+        }
+        chEvtUnregister(&CO->CANmodule[0]->rx_event, &can_el);
+        /* The rest of the stack adds receive buffers, the filters are set again */
+        CO_CANsetConfigurationMode(cand);
+        OD_CANNodeID = node_id;
+        OD_CANBitRate = bitrate;
+    }
+
+    return CO_CANopenInit(OD_CANNodeID);
+}
+#endif
+
 void oresat_init(void)
 {
     /*
@@ -46,7 +108,9 @@ void oresat_init(void)
      */
     halInit();
     chSysInit();
+    crc16_init();
     sensors_init();
+    start_sensors();
 
     return;
 }
@@ -66,17 +130,37 @@ void oresat_start(oresat_config_t *config)
         /* TODO: Implement Node ID system properly */
         OD_CANNodeID = config->node_id;
     }
+#if CO_NO_LSS_SERVER == 1
+    /* Otherwise keep a valid ID from the OD, and wait for LSS without one */
+    else if (OD_CANNodeID == 0 || OD_CANNodeID > 0x7F) {
+        OD_CANNodeID = CO_LSS_NODE_ID_ASSIGNMENT;
+    }
+
+    /* LSS fast scan tells nodes apart by identity, default the serial number from the MCU UID */
+    if (OD_identity.serialNumber == 0) {
+        const uint32_t *uid = (const uint32_t *)UID_BASE;
+        OD_identity.serialNumber = uid[0] ^ (uid[1] * 0x9E3779B1U) ^ (uid[2] * 0x85EBCA77U);
+    }
+#endif
 
     OD_CANBitRate = config->bitrate;
 
 
     oresat_tp = chThdGetSelfX();
 
+    /* Register CAN interrupt callbacks */
+    config->cand->rxfull_cb = CO_CANrx_cb;
+    config->cand->txempty_cb = CO_CANtx_cb;
+
     while (reset != CO_RESET_APP) {
         CO_ReturnError_t err;
 
         /* Initialize CAN Subsystem */
+#if CO_NO_LSS_SERVER == 1
+        err = oresat_lss_init(config->cand);
+#else
         err = CO_init(config->cand, OD_CANNodeID, OD_CANBitRate);
+#endif
         if (err != CO_ERROR_NO) {
             CO_errorReport(CO->em, CO_EM_MEMORY_ALLOCATION_ERROR, CO_EMC_SOFTWARE_INTERNAL, err);
         }
@@ -87,11 +171,14 @@ void oresat_start(oresat_config_t *config)
         reg_event(&event_registry, ORESAT_NMT_OPERATIONAL, nmt_handler);
         reg_event(&event_registry, ORESAT_NMT_NONOPERATIONAL, nmt_handler);
 
-        /* Register CAN interrupt callbacks */
-        config->cand->rxfull_cb = CO_CANrx_cb;
-        config->cand->txempty_cb = CO_CANtx_cb;
         CO_NMT_initCallback(CO->NMT, CO_NMT_cb);
 
+        /* Register OD access functions */
+        for (unsigned int i = 0; i < od_func_count; i++) {
+            CO_OD_configure(CO->SDO[0], od_funcs[i].index, od_funcs[i].func,
+                    od_funcs[i].object, NULL, 0);
+        }
+
         /* Enter normal operating mode */
         CO_CANsetNormalMode(CO->CANmodule[0]);
 
@@ -102,7 +189,6 @@ void oresat_start(oresat_config_t *config)
             uint16_t timeout_ms = ((typeof(timeout_ms))-1);
 
             /* Process all CO objects */
-            sensors_trig();
             reset = CO_process(CO, TIME_I2MS(chVTTimeElapsedSinceX(prev_time)), &timeout_ms);
             if (reset != CO_RESET_NOT)
                 continue;
@@ -7,6 +7,7 @@ PROJINC       = $(PROJ_SRC)/include             \
 
 PROJSRC       = $(PROJ_SRC)/CO_driver.c         \
                 $(PROJ_SRC)/CO_master.c         \
+                $(PROJ_SRC)/sdo_stream.c        \
                 $(CO_STACK)/CO_SDO.c            \
                 $(CO_STACK)/CO_Emergency.c      \
                 $(CO_STACK)/CO_NMT_Heartbeat.c  \
@@ -17,10 +18,11 @@ PROJSRC       = $(PROJ_SRC)/CO_driver.c         \
                 $(CO_STACK)/CO_LSSmaster.c      \
                 $(CO_STACK)/CO_LSSslave.c       \
                 $(CO_STACK)/CO_trace.c          \
-                $(CO_STACK)/crc16-ccitt.c       \
+                $(PROJ_SRC)/crc16.c             \
                 $(CANOPEN_SRC)/CANopen.c        \
                 $(PROJ_SRC)/events.c            \
                 $(PROJ_SRC)/sensors.c           \
+                $(PROJ_SRC)/sensor_sched.c      \
                 $(PROJ_SRC)/worker.c            \
                 $(PROJ_SRC)/oresat.c
 
@@ -0,0 +1,40 @@
+#include "sdo_stream.h"
+
+CO_SDO_abortCode_t sdo_stream_func(CO_ODF_arg_t *ODF_arg)
+{
+    const sdo_stream_t *stream = ODF_arg->object;
+    uint32_t len;
+    uint8_t peek;
+
+    if (stream == NULL)
+        return CO_SDO_AB_GENERAL;
+
+    if (ODF_arg->reading) {
+        if (stream->read == NULL)
+            return CO_SDO_AB_WRITEONLY;
+        if (ODF_arg->firstSegment && stream->size != NULL)
+            ODF_arg->dataLengthTotal = stream->size(stream->arg);
+        len = stream->read(stream->arg, ODF_arg->offset, ODF_arg->data, CO_SDO_BUFFER_SIZE);
+        /* The server rejects empty blocks */
+        if (len == 0)
+            return CO_SDO_AB_NO_DATA;
+        ODF_arg->dataLength = len;
+        /*
+         * The server calls again for the next block until the last one. A
+         * full block of unknown total size is the last if nothing follows.
+         */
+        if (len < CO_SDO_BUFFER_SIZE)
+            ODF_arg->lastSegment = true;
+        else if (ODF_arg->dataLengthTotal != 0)
+            ODF_arg->lastSegment = ODF_arg->offset + len >= ODF_arg->dataLengthTotal;
+        else
+            ODF_arg->lastSegment = stream->read(stream->arg, ODF_arg->offset + len, &peek, 1) == 0;
+    } else {
+        if (stream->write == NULL)
+            return CO_SDO_AB_READONLY;
+        if (!stream->write(stream->arg, ODF_arg->offset, ODF_arg->data, ODF_arg->dataLength, ODF_arg->lastSegment))
+            return CO_SDO_AB_DATA_TRANSF;
+    }
+
+    return CO_SDO_AB_NONE;
+}
@@ -0,0 +1,111 @@
+#include "sensor_sched.h"
+
+#define SENSOR_SCHED_EVENT  EVENT_MASK(0)
+
+#define time_sub(t, i)      ((systime_t)((t) - (i)))
+
+static sensor_t *sensors = NULL;
+static thread_t *sched_tp = NULL;
+static THD_WORKING_AREA(sched_wa, SENSOR_SCHED_WA_SIZE);
+
+void init_sensor(sensor_t *sensor, void *bus, sysinterval_t period, sensor_acquire_t acquire, void *dev, void *od)
+{
+    osalDbgCheck(sensor != NULL && acquire != NULL && period > SENSOR_SCHED_COALESCE);
+
+    sensor->bus = bus;
+    sensor->period = period;
+    sensor->acquire = acquire;
+    sensor->dev = dev;
+    sensor->od = od;
+    sensor->errors = 0;
+    sensor->due = false;
+    sensor->link = NULL;
+}
+
+void reg_sensor(sensor_t *sensor)
+{
+    osalDbgCheck(sensor != NULL);
+
+    chSysLock();
+    /* Due on the next pass */
+    sensor->next = chVTGetSystemTimeX();
+    sensor->link = sensors;
+    sensors = sensor;
+    if (sched_tp != NULL)
+        chEvtSignalI(sched_tp, SENSOR_SCHED_EVENT);
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+/* Run every due sensor on the same bus as first, in list order */
+static void run_bus(sensor_t *first)
+{
+    for (sensor_t *sp = first; sp; sp = sp->link) {
+        if (!sp->due || sp->bus != first->bus)
+            continue;
+        sp->due = false;
+        if (!sp->acquire(sp->dev, sp->od))
+            sp->errors++;
+    }
+}
+
+static THD_FUNCTION(sensor_sched, arg)
+{
+    (void)arg;
+
+    chRegSetThreadName("sensors");
+    while (!chThdShouldTerminateX()) {
+        sensor_t *head;
+        systime_t now;
+        sysinterval_t wait = TIME_INFINITE;
+
+        chSysLock();
+        head = sensors;
+        chSysUnlock();
+
+        /* Mark everything due within the coalescing window */
+        now = chVTGetSystemTime();
+        for (sensor_t *sp = head; sp; sp = sp->link) {
+            systime_t open = time_sub(sp->next, SENSOR_SCHED_COALESCE);
+
+            if (chTimeIsInRangeX(now, time_sub(sp->next, sp->period), open))
+                continue;
+            sp->due = true;
+            /* Keep the phase unless a whole period was missed */
+            if (chTimeIsInRangeX(now, open, chTimeAddX(sp->next, sp->period)))
+                sp->next = chTimeAddX(sp->next, sp->period);
+            else
+                sp->next = chTimeAddX(now, sp->period);
+        }
+
+        /* Batch the work per bus */
+        for (sensor_t *sp = head; sp; sp = sp->link) {
+            if (sp->due)
+                run_bus(sp);
+        }
+
+        /* Sleep until the next deadline or a new registration */
+        now = chVTGetSystemTime();
+        for (sensor_t *sp = head; sp; sp = sp->link) {
+            sysinterval_t left;
+
+            if (!chTimeIsInRangeX(now, time_sub(sp->next, sp->period), sp->next)) {
+                wait = TIME_IMMEDIATE;
+                break;
+            }
+            left = chTimeDiffX(now, sp->next);
+            if (wait == TIME_INFINITE || left < wait)
+                wait = left;
+        }
+        if (wait != TIME_IMMEDIATE)
+            chEvtWaitAnyTimeout(SENSOR_SCHED_EVENT, wait);
+    }
+
+    chThdExit(MSG_OK);
+}
+
+void start_sensors(void)
+{
+    if (sched_tp == NULL)
+        sched_tp = chThdCreateStatic(sched_wa, sizeof(sched_wa), SENSOR_SCHED_PRIO, sensor_sched, NULL);
+}
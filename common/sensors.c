@@ -2,45 +2,90 @@
 #include "hal.h"
 
 #include "sensors.h"
+#include "sensor_sched.h"
 #include "CANopen.h"
 
+#define SENSORS_CHANNELS    2
+#define SENSORS_DEPTH       (2 * SENSORS_OVERSAMPLE)
+/* Samples per channel in a decimated output */
+#define SENSORS_N           (SENSORS_OVERSAMPLE * SENSORS_DECIMATION)
+
 typedef struct {
     adcsample_t ts;
     adcsample_t vrefint;
 } sensors_t;
 
-sensors_t sensors;
+typedef struct {
+    uint32_t ts;
+    uint32_t vrefint;
+} sensors_sum_t;
+
+/* Circular DMA buffer, the callback runs once per half */
+static sensors_t samples[SENSORS_DEPTH];
+/* Boxcar accumulator and the last completed output */
+static sensors_sum_t acc;
+static sensors_sum_t out;
+static unsigned int halves;
+static bool ready;
+
+/* Double buffered snapshots, the writer fills the back one and flips */
+static sensors_snapshot_t snaps[2];
+static volatile unsigned int front;
+static volatile uint32_t seq;
+
+/* Snapshot sequence number, reloaded on every access */
+#define SNAP_SEQ(p)         (*(volatile uint32_t *)&(p)->seq)
+
+static sensor_t mcu_sensor;
+
+static bool sensors_acquire(void *dev, void *od);
 
 static void sensors_cb(ADCDriver *adcp)
 {
-    sensors_t *sensors = (sensors_t*)adcp->samples;
-    int16_t temperature;
-    int16_t voltage;
+    const sensors_t *s = adcIsBufferComplete(adcp) ? &samples[SENSORS_OVERSAMPLE] : samples;
 
-    voltage = VREFINT_CAL_VOLT * VREFINT_CAL / sensors->vrefint;
-    temperature = ((sensors->ts * VREFINT_CAL * 10 / sensors->vrefint) - TS_CAL1 * 10);
-    temperature = temperature * (TS_CAL2_TEMP - TS_CAL1_TEMP) / (TS_CAL2 - TS_CAL1) + TS_CAL1_TEMP * 10;
+    for (int i = 0; i < SENSORS_OVERSAMPLE; i++) {
+        acc.ts += s[i].ts;
+        acc.vrefint += s[i].vrefint;
+    }
 
-    OD_sensors[ODA_sensors_MCU_Temperature] = sensors->ts;
-    OD_sensors[ODA_sensors_MCU_VREFINT] = sensors->vrefint;
-    OD_temperature[ODA_temperature_MCU_Junction] = temperature;
-    OD_voltage[ODA_voltage_MCU_VDDA] = voltage;
+    if (++halves == SENSORS_DECIMATION) {
+        chSysLockFromISR();
+        out = acc;
+        ready = true;
+        chSysUnlockFromISR();
+        acc.ts = 0;
+        acc.vrefint = 0;
+        halves = 0;
+    }
 }
 
 static void sensors_err_cb(ADCDriver *adcp, adcerror_t err)
 {
     (void)adcp;
     (void)err;
+
+    /* The conversion stops, restart from a clean window */
+    acc.ts = 0;
+    acc.vrefint = 0;
+    halves = 0;
 }
 
-static ADCConversionGroup adcgrpcfg = {
-    FALSE,
-    sizeof(sensors_t)/sizeof(adcsample_t),
+static const ADCConversionGroup adcgrpcfg = {
+    TRUE,
+    SENSORS_CHANNELS,
     sensors_cb,
     sensors_err_cb,
     ADC_REG_CFG
 };
 
+static void sensors_start(void)
+{
+    adcAcquireBus(&ADCD1);
+    adcStartConversion(&ADCD1, &adcgrpcfg, (adcsample_t*)samples, SENSORS_DEPTH);
+    adcReleaseBus(&ADCD1);
+}
+
 void sensors_init(void)
 {
     adcStart(&ADCD1, NULL);
@@ -48,11 +93,88 @@ void sensors_init(void)
     OD_calibration[ODA_calibration_TS_CAL1] = TS_CAL1;
     OD_calibration[ODA_calibration_TS_CAL2] = TS_CAL2;
     OD_calibration[ODA_calibration_VREFINT_CAL] = VREFINT_CAL;
+    sensors_start();
+
+    /* The OD targets are spread over several arrays, written by acquire */
+    init_sensor(&mcu_sensor, &ADCD1, SENSORS_PERIOD, sensors_acquire, NULL, NULL);
+    reg_sensor(&mcu_sensor);
 }
 
-void sensors_trig(void)
+/*
+ * Copy out the latest snapshot without locking. Returns false if no
+ * output has been published yet.
+ */
+bool sensors_get(sensors_snapshot_t *snap)
 {
-    adcAcquireBus(&ADCD1);
-    adcStartConversion(&ADCD1, &adcgrpcfg, (adcsample_t*)(&sensors), sizeof(sensors)/sizeof(sensors_t));
-    adcReleaseBus(&ADCD1);
+    const sensors_snapshot_t *p;
+    uint32_t s;
+
+    do {
+        p = &snaps[front];
+        s = SNAP_SEQ(p);
+        __DMB();
+        *snap = *p;
+        __DMB();
+    } while (s != SNAP_SEQ(p) || (s == 0 && seq != 0));
+
+    return s != 0;
+}
+
+/* Calibrate the latest decimated output, if any, and publish it */
+static bool sensors_acquire(void *dev, void *od)
+{
+    sensors_snapshot_t *back = &snaps[front ^ 1];
+    sensors_sum_t sum;
+    uint32_t ts, vrefint;
+    int32_t temperature;
+
+    (void)dev;
+    (void)od;
+
+    chSysLock();
+    if (ADCD1.state == ADC_READY) {
+        /* Stopped by a DMA or overrun error */
+        chSysUnlock();
+        sensors_start();
+        return false;
+    }
+    if (!ready) {
+        chSysUnlock();
+        return true;
+    }
+    sum = out;
+    ready = false;
+    chSysUnlock();
+
+    /* Boxcar average with SENSORS_EXTRA_BITS fractional bits */
+    ts = (sum.ts << SENSORS_EXTRA_BITS) / SENSORS_N;
+    vrefint = (sum.vrefint << SENSORS_EXTRA_BITS) / SENSORS_N;
+    if (vrefint == 0)
+        return false;
+
+    temperature = (int32_t)(ts * VREFINT_CAL * 10 / vrefint) - TS_CAL1 * 10;
+    temperature = temperature * (TS_CAL2_TEMP - TS_CAL1_TEMP) / (TS_CAL2 - TS_CAL1) + TS_CAL1_TEMP * 10;
+
+    /* Fill the back buffer, a reader still on it sees seq change and retries */
+    SNAP_SEQ(back) = 0;
+    __DMB();
+    back->ts = ts >> SENSORS_EXTRA_BITS;
+    back->vrefint = vrefint >> SENSORS_EXTRA_BITS;
+    back->temperature = temperature;
+    back->voltage = (VREFINT_CAL_VOLT * VREFINT_CAL << SENSORS_EXTRA_BITS) / vrefint;
+    __DMB();
+    seq = seq + 1;
+    SNAP_SEQ(back) = seq;
+    __DMB();
+    front ^= 1;
+
+    /* One whole set per OD lock, SDO uploads copy under the same lock */
+    CO_LOCK_OD();
+    OD_sensors[ODA_sensors_MCU_Temperature] = back->ts;
+    OD_sensors[ODA_sensors_MCU_VREFINT] = back->vrefint;
+    OD_temperature[ODA_temperature_MCU_Junction] = back->temperature;
+    OD_voltage[ODA_voltage_MCU_VDDA] = back->voltage;
+    CO_UNLOCK_OD();
+
+    return true;
 }
@@ -0,0 +1,42 @@
+/*
+ * Host stand-in for the parts of CANopenNode v1.3 the tested common code
+ * uses, so it builds without ChibiOS and the CANopenNode submodule.
+ */
+#ifndef _CANOPEN_H_
+#define _CANOPEN_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* As in common/include/CO_driver.h */
+#define CO_SDO_BLOCK_SEGMENTS       127
+#define CO_SDO_BUFFER_SIZE          (7 * CO_SDO_BLOCK_SEGMENTS)
+
+typedef enum {
+    CO_SDO_AB_NONE              = 0x00000000UL,
+    CO_SDO_AB_WRITEONLY         = 0x06010001UL,
+    CO_SDO_AB_READONLY          = 0x06010002UL,
+    CO_SDO_AB_DEVICE_INCOMPAT   = 0x06040047UL,
+    CO_SDO_AB_GENERAL           = 0x08000000UL,
+    CO_SDO_AB_DATA_TRANSF       = 0x08000020UL,
+    CO_SDO_AB_NO_DATA           = 0x08000024UL
+} CO_SDO_abortCode_t;
+
+typedef struct {
+    void           *object;
+    uint8_t        *data;
+    const void     *ODdataStorage;
+    uint16_t        dataLength;
+    uint16_t        attribute;
+    uint8_t        *pFlags;
+    uint16_t        index;
+    uint8_t         subIndex;
+    bool            reading;
+    bool            firstSegment;
+    bool            lastSegment;
+    uint32_t        dataLengthTotal;
+    uint32_t        offset;
+} CO_ODF_arg_t;
+
+#endif
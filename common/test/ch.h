@@ -0,0 +1,9 @@
+/* Host stand-in for ChibiOS, for common code that only needs its types */
+#ifndef _CH_H_
+#define _CH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#endif
@@ -0,0 +1,7 @@
+/* As in CANopenNode v1.3 stack/crc16-ccitt.h */
+#ifndef CRC16_CCITT_H
+#define CRC16_CCITT_H
+
+unsigned short crc16_ccitt(const unsigned char block[], unsigned int blockLength, unsigned short crc);
+
+#endif
@@ -0,0 +1,7 @@
+/* Host stand-in for the ChibiOS HAL, no peripherals */
+#ifndef _HAL_H_
+#define _HAL_H_
+
+#include "ch.h"
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Host test of sdo_stream_func(). Drives it the way the CANopenNode v1.3
+ * SDO server does for a domain with an OD function: one SDO buffer per
+ * call, offset advanced by the returned length, and empty or oversized
+ * blocks rejected. Objects span several buffers so the multi-block read
+ * and the write path both run.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdo_stream.h"
+
+#define OBJ_MAX     (4 * CO_SDO_BUFFER_SIZE)
+
+#define CHECK(c) do { \
+        if (!(c)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            failures++; \
+        } \
+    } while (0)
+
+typedef struct {
+    uint8_t buf[OBJ_MAX];
+    uint32_t len;
+    bool sized;
+    uint32_t fail_at;           /* Write offset that fails, UINT32_MAX for none */
+    bool done;                  /* Last chunk written */
+} obj_t;
+
+static int failures;
+
+static uint32_t obj_size(void *arg)
+{
+    obj_t *obj = arg;
+
+    return obj->sized ? obj->len : 0;
+}
+
+static uint32_t obj_read(void *arg, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    obj_t *obj = arg;
+
+    if (offset >= obj->len)
+        return 0;
+    if (len > obj->len - offset)
+        len = obj->len - offset;
+    memcpy(buf, &obj->buf[offset], len);
+    return len;
+}
+
+static bool obj_write(void *arg, uint32_t offset, const uint8_t *buf, uint32_t len, bool last)
+{
+    obj_t *obj = arg;
+
+    if (offset != obj->len || offset + len > OBJ_MAX || offset == obj->fail_at)
+        return false;
+    memcpy(&obj->buf[offset], buf, len);
+    obj->len += len;
+    obj->done = last;
+    return true;
+}
+
+/* CO_SDO_initTransfer() for a domain, then CO_SDO_readOD() until the last block */
+static CO_SDO_abortCode_t upload(const sdo_stream_t *stream, uint8_t *out, uint32_t *out_len, int *calls)
+{
+    uint8_t sdo_buf[CO_SDO_BUFFER_SIZE];
+    CO_ODF_arg_t arg = {
+        .object = (void *)stream,
+        .data = sdo_buf,
+        .dataLength = CO_SDO_BUFFER_SIZE,
+        .reading = true,
+        .firstSegment = true,
+        .lastSegment = true,
+    };
+    CO_SDO_abortCode_t ret;
+
+    *out_len = 0;
+    *calls = 0;
+    do {
+        arg.dataLength = CO_SDO_BUFFER_SIZE;
+        ret = sdo_stream_func(&arg);
+        (*calls)++;
+        if (ret != CO_SDO_AB_NONE)
+            return ret;
+        if (arg.dataLength == 0 || arg.dataLength > CO_SDO_BUFFER_SIZE)
+            return CO_SDO_AB_DEVICE_INCOMPAT;
+        if (*out_len + arg.dataLength > OBJ_MAX)
+            return CO_SDO_AB_GENERAL;
+        memcpy(&out[*out_len], sdo_buf, arg.dataLength);
+        *out_len += arg.dataLength;
+        arg.offset += arg.dataLength;
+        arg.firstSegment = false;
+    } while (!arg.lastSegment);
+
+    return CO_SDO_AB_NONE;
+}
+
+/* CO_SDO_writeOD() each time the SDO buffer fills and once at the end */
+static CO_SDO_abortCode_t download(const sdo_stream_t *stream, const uint8_t *in, uint32_t len)
+{
+    uint8_t sdo_buf[CO_SDO_BUFFER_SIZE];
+    CO_ODF_arg_t arg = {
+        .object = (void *)stream,
+        .data = sdo_buf,
+        .reading = false,
+        .firstSegment = true,
+    };
+    CO_SDO_abortCode_t ret;
+
+    do {
+        arg.dataLength = len - arg.offset > CO_SDO_BUFFER_SIZE ? CO_SDO_BUFFER_SIZE : len - arg.offset;
+        arg.lastSegment = arg.offset + arg.dataLength == len;
+        memcpy(sdo_buf, &in[arg.offset], arg.dataLength);
+        ret = sdo_stream_func(&arg);
+        if (ret != CO_SDO_AB_NONE)
+            return ret;
+        arg.offset += arg.dataLength;
+        arg.firstSegment = false;
+    } while (!arg.lastSegment);
+
+    return CO_SDO_AB_NONE;
+}
+
+static void fill(obj_t *obj, uint32_t len, bool sized)
+{
+    memset(obj, 0, sizeof(*obj));
+    for (uint32_t i = 0; i < len; i++)
+        obj->buf[i] = (uint8_t)(i * 7 + (i >> 8));
+    obj->len = len;
+    obj->sized = sized;
+    obj->fail_at = UINT32_MAX;
+}
+
+static void test_upload(uint32_t len, bool sized)
+{
+    static obj_t obj;
+    static uint8_t out[OBJ_MAX];
+    sdo_stream_t stream = {obj_size, obj_read, NULL, &obj};
+    uint32_t out_len;
+    int calls;
+
+    fill(&obj, len, sized);
+    CHECK(upload(&stream, out, &out_len, &calls) == CO_SDO_AB_NONE);
+    CHECK(out_len == len);
+    CHECK(memcmp(out, obj.buf, len) == 0);
+    CHECK(calls == (int)((len + CO_SDO_BUFFER_SIZE - 1) / CO_SDO_BUFFER_SIZE));
+}
+
+static void test_download(uint32_t len)
+{
+    static obj_t src, dst;
+    sdo_stream_t stream = {obj_size, obj_read, obj_write, &dst};
+
+    fill(&src, len, true);
+    fill(&dst, 0, true);
+    CHECK(download(&stream, src.buf, len) == CO_SDO_AB_NONE);
+    CHECK(dst.len == len);
+    CHECK(dst.done);
+    CHECK(memcmp(dst.buf, src.buf, len) == 0);
+}
+
+static void test_errors(void)
+{
+    static obj_t obj;
+    static uint8_t out[OBJ_MAX];
+    sdo_stream_t ro = {obj_size, obj_read, NULL, &obj};
+    sdo_stream_t wo = {NULL, NULL, obj_write, &obj};
+    uint32_t out_len;
+    int calls;
+
+    fill(&obj, 0, true);
+    CHECK(upload(&ro, out, &out_len, &calls) == CO_SDO_AB_NO_DATA);
+    CHECK(upload(&wo, out, &out_len, &calls) == CO_SDO_AB_WRITEONLY);
+    CHECK(download(&ro, out, 10) == CO_SDO_AB_READONLY);
+
+    /* A failing sink aborts the transfer at that block */
+    fill(&obj, 0, true);
+    obj.fail_at = CO_SDO_BUFFER_SIZE;
+    CHECK(download(&wo, out, 3 * CO_SDO_BUFFER_SIZE) == CO_SDO_AB_DATA_TRANSF);
+    CHECK(obj.len == CO_SDO_BUFFER_SIZE);
+    CHECK(!obj.done);
+}
+
+int main(void)
+{
+    static const uint32_t lens[] = {
+        1,
+        CO_SDO_BUFFER_SIZE - 1,
+        CO_SDO_BUFFER_SIZE,
+        CO_SDO_BUFFER_SIZE + 1,
+        2 * CO_SDO_BUFFER_SIZE,
+        3 * CO_SDO_BUFFER_SIZE + 100,
+        OBJ_MAX,
+    };
+
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        test_upload(lens[i], true);
+        test_upload(lens[i], false);
+        test_download(lens[i]);
+    }
+    test_errors();
+
+    if (failures != 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("sdo_stream: ok\n");
+    return 0;
+}
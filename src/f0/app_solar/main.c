@@ -38,7 +38,8 @@ static void app_init(void)
     /* App initialization */
     /*init_worker(&worker1, "Solar Application", solar_wa, sizeof(solar_wa), NORMALPRIO, solar, NULL);*/
     /*reg_worker(&worker1);*/
-    chThdCreateStatic(solar_wa, sizeof(solar_wa), NORMALPRIO, solar, NULL);
+    chThdCreateStatic(solar_wa, sizeof(solar_wa), NORMALPRIO + 1, solar, NULL);
+    reg_od_func(OD_2112_IVCurve, sdo_stream_func, (void *)&ivcurve_stream);
 
     /* Start up debug output */
     sdStart(&SD2, NULL);
@@ -0,0 +1,517 @@
+/*
+ * Closed-loop MPPT benchmark. Runs the firmware tracker (calc_mppt) against
+ * a single-diode panel model and a charger model driven by the DAC setpoint,
+ * replays irradiance and temperature profiles and reports tracking
+ * efficiency, convergence time and power ripple. The convergence time and
+ * ripple the tracker reports are checked against the same metrics taken
+ * from the true panel power.
+ */
+#include <getopt.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mppt.h"
+#include "pv.h"
+
+#define DT              1e-3    /* Tracker period, the MPPTLoop period default */
+#define CONV_TIME       0.7e-3  /* INA226 conversion after the setpoint write, LOOP_CONV_TIME */
+#define DELAY_MAX       8       /* Longest modelled sample delay, periods */
+#define VBUS_LSB        1.25e-3 /* INA226 VBUS LSB, V */
+#define CURR_LSB        10e-6   /* INA226 current LSB, A */
+#define DAC_LSB         5       /* MAX5805 12 bit at 2.048 V, 0.1 mV units */
+#define IADJ_MAX        20475
+#define IADJ_START      15000
+#define RIPPLE_TIME     1.0     /* Tail used for the measured ripple, s */
+#define CONV_TOL        0.1     /* Reported and measured metrics agree within 10 % */
+#define CONV_TOL_MS     20.0    /* or 20 ms */
+#define RIPPLE_TOL_MW   10.0    /* or 10 mW, about the sensor noise */
+#define BAND_TIGHT      0.8     /* Settle band range the reported convergence time */
+#define BAND_LOOSE      1.25    /* may come from, noise moves the band edge */
+
+typedef struct {
+    double t;
+    double irr;
+    double temp;
+    double shade;
+} sample_t;
+
+/*
+ * The tracker metrics (mppt_metrics) computed on the true power of the
+ * samples the tracker took, without quantization and noise. scale widens or
+ * narrows the settle band.
+ */
+typedef struct {
+    double scale;
+    uint32_t iter;
+    uint32_t start;
+    bool settled;
+    int run_len;
+    uint32_t run_start;
+    double run_min;
+    double run_max;
+    uint32_t conv_time;
+    double pwr_min;
+    double pwr_max;
+    int window;
+    double ripple;
+} ref_t;
+
+/* shade is the irradiance factor for the second half of the cells */
+typedef struct {
+    const char *name;
+    double duration;
+    void (*env)(double t, double *irr, double *temp, double *shade);
+} profile_t;
+
+/* Tracker defaults, kept in sync with the solarPanel OD defaults */
+static mppt_cfg_t cfg = {
+    MPPT_ALGO_IC,
+    5,
+    200,
+    1311,
+    20,
+    0,
+    IADJ_MAX,
+    (760 * 67109) >> 10,
+    1000,
+    30000
+};
+
+/* Four 3J cells sized so the INA226 current register does not saturate */
+static pv_param_t panel = {
+    4,
+    0.30,
+    2.69,
+    3.4,
+    0.05,
+    0.0006,
+    -0.0062,
+    0.5,
+    28.0
+};
+
+static conv_t charger = {
+    0.2e-3,
+    47e-6,
+    1.0,
+    0.0,
+    0.0
+};
+
+static double noise_lsb = 1.0;
+static int delay;
+static sample_t *trace;
+static size_t trace_len;
+
+static void env_steady(double t, double *irr, double *temp, double *shade)
+{
+    (void)t;
+    *irr = 1.0;
+    *temp = 28.0;
+    *shade = 1.0;
+}
+
+/* Coming out of eclipse: the limb transition, then the cold panel warms up */
+static void env_sunrise(double t, double *irr, double *temp, double *shade)
+{
+    double x = (t - 2.0) / 6.0;
+
+    *shade = 1.0;
+    *irr = x <= 0.0 ? 0.0 : x >= 1.0 ? 1.0 : x * x * (3.0 - 2.0 * x);
+    *temp = -40.0 + 60.0 * (1.0 - exp(-t / 300.0));
+}
+
+/* Going into eclipse through the penumbra */
+static void env_eclipse(double t, double *irr, double *temp, double *shade)
+{
+    double x = (t - 10.0) / 8.0;
+
+    *shade = 1.0;
+    *irr = x <= 0.0 ? 1.0 : x >= 1.0 ? 0.0 : 1.0 - x * x * (3.0 - 2.0 * x);
+    *temp = 60.0 - 20.0 * (1.0 - exp(-t / 300.0));
+}
+
+/* Tumbling at 6 rpm with some earth albedo */
+static void env_tumble(double t, double *irr, double *temp, double *shade)
+{
+    double c = cos(2.0 * M_PI * t / 10.0);
+
+    *shade = 1.0;
+    *irr = 0.05 + (c > 0.0 ? c : 0.0);
+    *temp = 20.0 + 5.0 * sin(2.0 * M_PI * t / 60.0);
+}
+
+/*
+ * Partly shaded panel, for example by a deployable. The tracker starts on
+ * the high voltage peak, the global maximum is with the shaded cell bypassed.
+ */
+static void env_shaded(double t, double *irr, double *temp, double *shade)
+{
+    (void)t;
+    *irr = 1.0;
+    *temp = 28.0;
+    *shade = 0.3;
+}
+
+/* Linear interpolation of a loaded profile */
+static void env_file(double t, double *irr, double *temp, double *shade)
+{
+    size_t k = 1;
+
+    while (k < trace_len - 1 && trace[k].t < t)
+        k++;
+    if (t <= trace[0].t) {
+        *irr = trace[0].irr;
+        *temp = trace[0].temp;
+        *shade = trace[0].shade;
+    } else if (t >= trace[trace_len - 1].t) {
+        *irr = trace[trace_len - 1].irr;
+        *temp = trace[trace_len - 1].temp;
+        *shade = trace[trace_len - 1].shade;
+    } else {
+        double x = (t - trace[k - 1].t) / (trace[k].t - trace[k - 1].t);
+        *irr = trace[k - 1].irr + x * (trace[k].irr - trace[k - 1].irr);
+        *temp = trace[k - 1].temp + x * (trace[k].temp - trace[k - 1].temp);
+        *shade = trace[k - 1].shade + x * (trace[k].shade - trace[k - 1].shade);
+    }
+}
+
+static profile_t profiles[] = {
+    {"steady", 10.0, env_steady},
+    {"sunrise", 30.0, env_sunrise},
+    {"eclipse", 30.0, env_eclipse},
+    {"tumble", 60.0, env_tumble},
+    {"shaded", 60.0, env_shaded},
+};
+
+#define NUM_PROFILES    (sizeof(profiles) / sizeof(profiles[0]))
+
+static const char *algo_names[MPPT_ALGO_COUNT] = {"po", "ic", "focv"};
+
+/*
+ * CSV with time (s), irradiance (fraction of AM0), temperature (C) and
+ * optionally the shading factor for the second half of the cells.
+ */
+static int load_profile(const char *path, profile_t *prof)
+{
+    FILE *f = fopen(path, "r");
+    char line[128];
+    sample_t s;
+    size_t cap = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    trace_len = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        s.shade = 1.0;
+        if (sscanf(line, "%lf,%lf,%lf,%lf", &s.t, &s.irr, &s.temp, &s.shade) < 3)
+            continue;
+        if (trace_len == cap) {
+            cap = cap ? cap * 2 : 64;
+            trace = realloc(trace, cap * sizeof(*trace));
+        }
+        trace[trace_len++] = s;
+    }
+    fclose(f);
+    if (trace_len < 2) {
+        fprintf(stderr, "%s: need at least two samples\n", path);
+        return -1;
+    }
+    prof->name = path;
+    prof->duration = trace[trace_len - 1].t;
+    prof->env = env_file;
+    return 0;
+}
+
+/* Deterministic approximately gaussian noise in LSBs */
+static double noise(void)
+{
+    static uint32_t seed = 1;
+    double sum = 0.0;
+
+    for (int k = 0; k < 4; k++) {
+        seed = seed * 1664525U + 1013904223U;
+        sum += (double)(seed >> 8) / (1 << 24);
+    }
+    return (sum - 2.0) * noise_lsb * 1.732;
+}
+
+static long quantize(double x, double lsb, long min, long max)
+{
+    long q = lround(x / lsb + noise());
+
+    return q < min ? min : q > max ? max : q;
+}
+
+static void ref_reset(ref_t *ref)
+{
+    ref->start = ref->iter;
+    ref->settled = false;
+    ref->run_len = 0;
+    ref->window = 0;
+    ref->ripple = 0.0;
+}
+
+static void ref_add(ref_t *ref, double pwr)
+{
+    ref->iter++;
+
+    if (ref->run_len > 0) {
+        double lo = fmin(pwr, ref->run_min), hi = fmax(pwr, ref->run_max);
+        double band = ref->scale * fmax(fabs(hi) / (1 << MPPT_SETTLE_SHIFT),
+                MPPT_SETTLE_FLOOR * VBUS_LSB * CURR_LSB);
+
+        if (hi - lo > band) {
+            if (ref->settled)
+                ref->start = ref->iter;
+            ref->settled = false;
+            ref->run_len = 0;
+        } else {
+            ref->run_min = lo;
+            ref->run_max = hi;
+        }
+    }
+    if (ref->run_len == 0) {
+        ref->run_start = ref->iter;
+        ref->run_min = pwr;
+        ref->run_max = pwr;
+    }
+    if (ref->run_len < MPPT_SETTLE_COUNT && ++ref->run_len == MPPT_SETTLE_COUNT &&
+            !ref->settled) {
+        ref->settled = true;
+        ref->conv_time = ref->run_start - ref->start;
+    }
+
+    if (ref->window == 0 || pwr < ref->pwr_min)
+        ref->pwr_min = pwr;
+    if (ref->window == 0 || pwr > ref->pwr_max)
+        ref->pwr_max = pwr;
+    if (++ref->window >= MPPT_RIPPLE_WINDOW) {
+        ref->ripple = ref->pwr_max - ref->pwr_min;
+        ref->window = 0;
+    }
+}
+
+static bool agree(double reported, double lo, double hi, double tol)
+{
+    if (lo > hi) {
+        double x = lo;
+        lo = hi;
+        hi = x;
+    }
+    return reported >= lo - fmax(tol, CONV_TOL * lo) &&
+        reported <= hi + fmax(tol, CONV_TOL * hi);
+}
+
+/*
+ * Each period models the firmware loop: the setpoint is written, the INA226
+ * converts for CONV_TIME and the tracker runs on that sample. The charger
+ * keeps the setpoint for the rest of the period. -D delays the samples by
+ * whole periods, as a free running INA226 read right after the write would.
+ */
+static bool run(const profile_t *prof, mppt_algo_t algo, FILE *out, double *eff)
+{
+    mppt_t mppt;
+    pv_panel_t pv;
+    conv_t cv = charger;
+    double irr = -1.0, temp = 0.0, shade = 1.0;
+    double last_irr = -1.0, last_temp = 0.0, last_shade = 1.0;
+    double cells[PV_MAX_CELLS];
+    double v, i, p, vr, ir, energy = 0.0, ideal = 0.0;
+    double vq[DELAY_MAX + 1], iq[DELAY_MAX + 1], pq[DELAY_MAX + 1];
+    double conv_ms, ripple_mw, ref_conv_ms, ref_ripple_mw;
+    ref_t ref[3] = {{.scale = 1.0}, {.scale = BAND_TIGHT}, {.scale = BAND_LOOSE}};
+    uint32_t iter;
+    bool ok;
+    double t0 = -1.0, t99 = -1.0, p_min = INFINITY, p_max = -INFINITY;
+    uint32_t iadj = IADJ_START;
+    long steps = lround(prof->duration / DT);
+    mppt_cfg_t c = cfg;
+
+    c.algo = algo;
+    pv_init(&pv, &panel);
+    mppt_init(&mppt, &c);
+
+    for (long k = 0; k < steps; k++) {
+        double t = k * DT;
+
+        prof->env(t, &irr, &temp, &shade);
+        if (irr != last_irr || temp != last_temp || shade != last_shade) {
+            for (int n = 0; n < panel.cells; n++)
+                cells[n] = n < panel.cells / 2 ? 1.0 : shade;
+            pv_set_env(&pv, irr, temp, cells);
+            last_irr = irr;
+            last_temp = temp;
+            last_shade = shade;
+        }
+
+        conv_step(&cv, &pv, iadj / DAC_LSB * DAC_LSB, CONV_TIME, &v, &i);
+        conv_step(&cv, &pv, iadj / DAC_LSB * DAC_LSB, DT - CONV_TIME, &vr, &ir);
+        p = (v * i * CONV_TIME + vr * ir * (DT - CONV_TIME)) / DT;
+        energy += p * DT;
+        ideal += pv.pmp * DT;
+        if (t0 < 0.0 && pv.pmp > 0.0)
+            t0 = t;
+        if (t99 < 0.0 && pv.pmp > 0.0 && p >= 0.99 * pv.pmp)
+            t99 = t - t0;
+        if (t >= prof->duration - RIPPLE_TIME) {
+            if (p < p_min)
+                p_min = p;
+            if (p > p_max)
+                p_max = p;
+        }
+
+        /* Sample pipeline, the oldest entry is the one the tracker gets */
+        memmove(&vq[1], &vq[0], delay * sizeof(vq[0]));
+        memmove(&iq[1], &iq[0], delay * sizeof(iq[0]));
+        memmove(&pq[1], &pq[0], delay * sizeof(pq[0]));
+        vq[0] = v;
+        iq[0] = i;
+        pq[0] = v * i;
+        if (k < delay)
+            continue;
+
+        iter = mppt.iter;
+        calc_mppt(&mppt, quantize(vq[delay], VBUS_LSB, 0, UINT16_MAX),
+                quantize(iq[delay], CURR_LSB, INT16_MIN, INT16_MAX), &iadj);
+
+        /* Follow the tracker, measured on the power of the current period */
+        for (int n = 0; n < 3; n++) {
+            if (mppt.iter != iter)
+                ref_add(&ref[n], pq[0]);
+            else if (mppt.start == mppt.iter && mppt.run_len == 0)
+                ref_reset(&ref[n]);
+        }
+
+        if (out != NULL)
+            fprintf(out, "%.3f,%s,%s,%.4f,%.2f,%.4f,%.5f,%.5f,%.5f,%u\n", t,
+                    prof->name, algo_names[algo], irr, temp, v, i, p, pv.pmp,
+                    iadj);
+    }
+
+    conv_ms = (double)mppt.conv_time * DT * 1000.0;
+    ripple_mw = mppt.ripple * VBUS_LSB * CURR_LSB * 1000.0;
+    ref_conv_ms = (double)ref[0].conv_time * DT * 1000.0;
+    ref_ripple_mw = ref[0].ripple * 1000.0;
+    ok = agree(conv_ms, (double)ref[1].conv_time * DT * 1000.0,
+            (double)ref[2].conv_time * DT * 1000.0, CONV_TOL_MS) &&
+        agree(ripple_mw, ref_ripple_mw, ref_ripple_mw, RIPPLE_TOL_MW);
+
+    *eff = ideal > 0.0 ? 100.0 * energy / ideal : 100.0;
+    printf("%-8s %-5s %9.3f %9.3f %7.2f %9.0f %9.0f %9.0f %9.3f %9.3f %9.3f%s\n",
+            prof->name, algo_names[algo], energy, ideal,
+            ideal > 0.0 ? 100.0 * energy / ideal : 0.0,
+            t99 < 0.0 ? -1.0 : t99 * 1000.0, conv_ms, ref_conv_ms,
+            ripple_mw, ref_ripple_mw,
+            p_max > p_min ? (p_max - p_min) * 1000.0 : 0.0,
+            ok ? "" : "  metrics disagree");
+    return ok;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -a ALGO     po, ic, focv or all (default all)\n"
+        "  -p PROFILE  steady, sunrise, eclipse, tumble, shaded or all (default all)\n"
+        "  -f FILE     replay a time,irradiance,temperature[,shade] CSV profile\n"
+        "  -d SECONDS  override the profile duration\n"
+        "  -s STEP     minimum step in 0.1 mV (default %u)\n"
+        "  -S STEP     maximum step in 0.1 mV (default %u)\n"
+        "  -g GAIN     adaptive step gain, Q16 (default %d)\n"
+        "  -b BAND     deadband (default %u)\n"
+        "  -r RATIO    fractional Voc ratio in 0.1 %% (default 760)\n"
+        "  -w MS       global sweep period, 0 disables (default %u)\n"
+        "  -n LSB      sensor noise in LSBs (default %.1f)\n"
+        "  -D PERIODS  delay the samples by whole periods (default 0, max %d)\n"
+        "  -t PERCENT  fail if any run tracks below PERCENT efficiency\n"
+        "  -o FILE     write a per step CSV trace\n",
+        prog, cfg.step_min, cfg.step_max, cfg.gain, cfg.deadband,
+        cfg.sweep_period, noise_lsb, DELAY_MAX);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *algo_arg = "all", *prof_arg = "all";
+    profile_t file_prof = {NULL, 0.0, NULL};
+    double duration = 0.0, threshold = 0.0, eff, worst = 100.0;
+    FILE *out = NULL;
+    int opt, ret = 0;
+
+    while ((opt = getopt(argc, argv, "a:p:f:d:s:S:g:b:r:w:n:D:t:o:h")) != -1) {
+        switch (opt) {
+        case 'a': algo_arg = optarg; break;
+        case 'p': prof_arg = optarg; break;
+        case 'f':
+            if (load_profile(optarg, &file_prof) != 0)
+                return 2;
+            prof_arg = NULL;
+            break;
+        case 'd': duration = atof(optarg); break;
+        case 's': cfg.step_min = atoi(optarg); break;
+        case 'S': cfg.step_max = atoi(optarg); break;
+        case 'g': cfg.gain = atoi(optarg); break;
+        case 'b': cfg.deadband = atoi(optarg); break;
+        case 'r': cfg.focv_ratio = (atoi(optarg) * 67109) >> 10; break;
+        case 'w': cfg.sweep_period = atoi(optarg); break;
+        case 'n': noise_lsb = atof(optarg); break;
+        case 'D':
+            delay = atoi(optarg);
+            if (delay < 0 || delay > DELAY_MAX) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 't': threshold = atof(optarg); break;
+        case 'o':
+            out = fopen(optarg, "w");
+            if (out == NULL) {
+                perror(optarg);
+                return 2;
+            }
+            fprintf(out, "t,profile,algo,irr,temp,v,i,p,pmp,iadj\n");
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    printf("%-8s %-5s %9s %9s %7s %9s %9s %9s %9s %9s %9s\n", "profile", "algo",
+            "energy_J", "ideal_J", "eff_%", "t99_ms", "conv_ms", "settle_ms",
+            "ripple_mW", "wp2p_mW", "p2p_mW");
+    for (size_t n = 0; n < NUM_PROFILES || prof_arg == NULL; n++) {
+        profile_t prof = prof_arg == NULL ? file_prof : profiles[n];
+
+        if (prof_arg != NULL && strcmp(prof_arg, "all") != 0 &&
+                strcmp(prof_arg, prof.name) != 0)
+            continue;
+        if (duration > 0.0)
+            prof.duration = duration;
+        for (int a = 0; a < MPPT_ALGO_COUNT; a++) {
+            if (strcmp(algo_arg, "all") != 0 && strcmp(algo_arg, algo_names[a]) != 0)
+                continue;
+            if (!run(&prof, a, out, &eff))
+                ret = 1;
+            if (eff < worst)
+                worst = eff;
+        }
+        if (prof_arg == NULL)
+            break;
+    }
+
+    if (out != NULL)
+        fclose(out);
+    if (threshold > 0.0 && worst < threshold) {
+        fprintf(stderr, "tracking efficiency %.2f %% below %.2f %%\n", worst, threshold);
+        return 1;
+    }
+    if (ret != 0)
+        fprintf(stderr, "reported metrics disagree with the measured ones\n");
+    return ret;
+}
@@ -0,0 +1,160 @@
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pv.h"
+#include "mppt.h"
+
+#define K_Q             8.617333e-5     /* Boltzmann constant over charge, V/K */
+#define KELVIN          273.15
+#define MPP_SCAN        64
+#define CONV_SUBSTEPS   25
+
+void pv_init(pv_panel_t *pv, const pv_param_t *p)
+{
+    pv->p = *p;
+    pv->i_last = 0.0;
+    pv_set_env(pv, 1.0, p->t_ref, NULL);
+}
+
+/* String voltage at current i and its derivative */
+static double pv_vstring(const pv_panel_t *pv, double i, double *dv)
+{
+    const pv_param_t *p = &pv->p;
+    double v = 0.0, d = 0.0, x, vk;
+
+    for (int k = 0; k < p->cells; k++) {
+        x = pv->iph[k] - i + pv->i0;
+        vk = x > 0.0 ? pv->nvt * log(x / pv->i0) - i * p->rs : -p->vbp;
+        if (vk <= -p->vbp) {
+            /* Cell reverse biased, the bypass diode carries the current */
+            v -= p->vbp;
+        } else {
+            v += vk;
+            d -= pv->nvt / x + p->rs;
+        }
+    }
+    *dv = d;
+    return v;
+}
+
+/* String current at terminal voltage v, safeguarded Newton on V(I) */
+double pv_current(pv_panel_t *pv, double v)
+{
+    double lo = 0.0, hi = 0.0, i, f, d, next;
+
+    for (int k = 0; k < pv->p.cells; k++)
+        if (pv->iph[k] > hi)
+            hi = pv->iph[k];
+    if (hi <= 0.0 || v >= pv_vstring(pv, 0.0, &d))
+        return 0.0;
+
+    i = pv->i_last > lo && pv->i_last < hi ? pv->i_last : hi / 2;
+    for (int k = 0; k < 60; k++) {
+        f = pv_vstring(pv, i, &d) - v;
+        if (fabs(f) < 1e-7)
+            break;
+        if (f > 0.0)
+            lo = i;
+        else
+            hi = i;
+        next = d < 0.0 ? i - f / d : -1.0;
+        if (next <= lo || next >= hi)
+            next = (lo + hi) / 2;
+        i = next;
+    }
+    pv->i_last = i;
+    return i;
+}
+
+/*
+ * Update the model for irradiance (fraction of AM0), cell temperature and
+ * optional per cell shading factors.
+ */
+void pv_set_env(pv_panel_t *pv, double irr, double temp, const double *shade)
+{
+    const pv_param_t *p = &pv->p;
+    double isc, voc, v, pwr, step;
+
+    if (irr < 0.0)
+        irr = 0.0;
+    pv->nvt = p->n * K_Q * (temp + KELVIN);
+    isc = p->isc * (1.0 + p->alpha * (temp - p->t_ref));
+    voc = p->voc + p->beta * (temp - p->t_ref);
+    pv->i0 = isc / expm1(voc / pv->nvt);
+    for (int k = 0; k < p->cells; k++) {
+        pv->shade[k] = shade != NULL ? shade[k] : 1.0;
+        pv->iph[k] = irr * pv->shade[k] * isc;
+    }
+
+    pv->voc = pv_vstring(pv, 0.0, &v);
+    pv->vmp = 0.0;
+    pv->pmp = 0.0;
+    if (pv->voc <= 0.0) {
+        pv->voc = 0.0;
+        return;
+    }
+
+    /* Global maximum, P(V) has one peak per shading level */
+    step = pv->voc / MPP_SCAN;
+    for (int k = 1; k < MPP_SCAN; k++) {
+        v = k * step;
+        pwr = v * pv_current(pv, v);
+        if (pwr > pv->pmp) {
+            pv->pmp = pwr;
+            pv->vmp = v;
+        }
+    }
+    for (int r = 0; r < 3; r++) {
+        double c = pv->vmp;
+        step /= 10;
+        for (int k = -10; k <= 10; k++) {
+            v = c + k * step;
+            pwr = v * pv_current(pv, v);
+            if (pwr > pv->pmp) {
+                pv->pmp = pwr;
+                pv->vmp = v;
+            }
+        }
+    }
+}
+
+/* Charger current limit in A for an IADJ setpoint, inverts calc_iadj() */
+double conv_ilim(uint32_t iadj)
+{
+    uint32_t lo = 0, hi = 50520000 / MPPT_RSENSE;
+
+    if (calc_iadj(hi) >= iadj)
+        return hi * 1e-6;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (calc_iadj(mid) > iadj)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo * 1e-6;
+}
+
+/* Advance the charger by dt and return the mean panel operating point */
+void conv_step(conv_t *cv, pv_panel_t *pv, uint32_t iadj, double dt,
+        double *v, double *i)
+{
+    double i_set = conv_ilim(iadj);
+    double h = dt / CONV_SUBSTEPS;
+    double a = 1.0 - exp(-h / cv->tau);
+    double ipv, iin, sv = 0.0, si = 0.0;
+
+    for (int k = 0; k < CONV_SUBSTEPS; k++) {
+        cv->i_in += (i_set - cv->i_in) * a;
+        ipv = pv_current(pv, cv->v);
+        iin = cv->v <= cv->vreg && cv->i_in > ipv ? ipv : cv->i_in;
+        cv->v += (ipv - iin) * h / cv->cin;
+        if (cv->v < 0.0)
+            cv->v = 0.0;
+        sv += cv->v;
+        si += ipv;
+    }
+    *v = sv / CONV_SUBSTEPS;
+    *i = si / CONV_SUBSTEPS;
+}
@@ -0,0 +1,64 @@
+#ifndef _PV_H_
+#define _PV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PV_MAX_CELLS    8
+
+/*
+ * Single-diode PV cell model, cells in series with a bypass diode each.
+ * Reference values are per cell at AM0 and t_ref.
+ */
+typedef struct {
+    int    cells;
+    double isc;         /* Short circuit current, A */
+    double voc;         /* Open circuit voltage, V */
+    double n;           /* Diode ideality factor */
+    double rs;          /* Series resistance, ohm */
+    double alpha;       /* Isc temperature coefficient, 1/K */
+    double beta;        /* Voc temperature coefficient, V/K */
+    double vbp;         /* Bypass diode forward voltage, V */
+    double t_ref;       /* Reference temperature, C */
+} pv_param_t;
+
+typedef struct {
+    pv_param_t p;
+    double shade[PV_MAX_CELLS];
+    double iph[PV_MAX_CELLS];
+    double i0;
+    double nvt;
+    double i_last;
+    double vmp;
+    double pmp;
+    double voc;
+} pv_panel_t;
+
+/*
+ * Charger model. The charger regulates its input current to the limit the
+ * IADJ pin voltage sets through the inverse of calc_iadj(), following it
+ * with a first order lag. The panel voltage is the input capacitor voltage,
+ * when the limit exceeds what the panel can source the input collapses
+ * until the charger input voltage regulation holds it at vreg.
+ */
+typedef struct {
+    double tau;         /* Current loop time constant, s */
+    double cin;         /* Input capacitance, F */
+    double vreg;        /* Input voltage regulation floor, V */
+    double i_in;        /* Present input current, A */
+    double v;           /* Input capacitor voltage, V */
+} conv_t;
+
+void pv_init(pv_panel_t *pv, const pv_param_t *p);
+void pv_set_env(pv_panel_t *pv, double irr, double temp, const double *shade);
+double pv_current(pv_panel_t *pv, double v);
+
+double conv_ilim(uint32_t iadj);
+void conv_step(conv_t *cv, pv_panel_t *pv, uint32_t iadj, double dt,
+        double *v, double *i);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
@@ -51,7 +51,7 @@ struct sCO_OD_ROM CO_OD_ROM = {
 /*1803*/ {0x6L, 0x0480L, 0xFEL, 0x00, 0x0L, 0x00, 0x0L}},
 /*1A00*/ {{0x2L, 0x21080110L, 0x21090110L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
 /*1A01*/ {0x3L, 0x21100110L, 0x21100210L, 0x21100310L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
-/*1A02*/ {0x0L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
+/*1A02*/ {0x4L, 0x21130910L, 0x21130B10L, 0x21130A10L, 0x21130C10L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
 /*1A03*/ {0x0L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L}},
 /*1F80*/ 0x0000L,
 /*2101*/ 0x4L,
@@ -79,7 +79,13 @@ struct sCO_OD_RAM CO_OD_RAM = {
 /*2107*/ {0x00, 0x00, 0x00},
 /*2108*/ {0x00},
 /*2109*/ {0x00},
-/*2110*/ {0x3L, 0x00, 0x00, 0x00},
+/*2110*/ {0xDL, 0x00, 0x00, 0x00, 0x0000L, 0x00, 0x1L, 0x05, 0xC8, 0x51F, 0x14, 0x2F8, 0x3E8, 0x7530L},
+/*2111*/ {0x4L, 0x3E8, 0x00, 0x00, 0x0000L},
+/*2113*/ {0xCL, 0x3E8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+/*2120*/ {0x5L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
+/*2121*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2122*/ {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+/*2123*/ {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
 
            CO_OD_FIRST_LAST_WORD,
 };
@@ -275,11 +281,54 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
            {(void*)&CO_OD_ROM.TPDOMappingParameter[3].mappedObject8, 0x8D, 0x4 },
 };
 
-/*0x2110*/ const CO_OD_entryRecord_t OD_record2110[4] = {
+/*0x2110*/ const CO_OD_entryRecord_t OD_record2110[14] = {
            {(void*)&CO_OD_RAM.solarPanel.maxSubIndex, 0x06, 0x1 },
            {(void*)&CO_OD_RAM.solarPanel.voltage, 0xA6, 0x2 },
            {(void*)&CO_OD_RAM.solarPanel.current, 0xA6, 0x2 },
            {(void*)&CO_OD_RAM.solarPanel.power, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.convergenceTime, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.solarPanel.ripple, 0x86, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.algorithm, 0x0E, 0x1 },
+           {(void*)&CO_OD_RAM.solarPanel.stepMin, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.stepMax, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.gain, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.deadband, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.focvRatio, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.focvPeriod, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarPanel.sweepPeriod, 0x8E, 0x4 },
+};
+
+/*0x2111*/ const CO_OD_entryRecord_t OD_record2111[5] = {
+           {(void*)&CO_OD_RAM.MPPTLoop.maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.MPPTLoop.period, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.MPPTLoop.jitter, 0x86, 0x2 },
+           {(void*)&CO_OD_RAM.MPPTLoop.maxJitter, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.MPPTLoop.overrunCount, 0x86, 0x4 },
+};
+
+/*0x2113*/ const CO_OD_entryRecord_t OD_record2113[13] = {
+           {(void*)&CO_OD_RAM.solarStats.maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.solarStats.window, 0x8E, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.samples, 0x86, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.voltageMin, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.voltageMax, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.voltageMean, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.currentMin, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.currentMax, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.currentMean, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.powerMin, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.powerMax, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.powerMean, 0xA6, 0x2 },
+           {(void*)&CO_OD_RAM.solarStats.energy, 0xA6, 0x2 },
+};
+
+/*0x2120*/ const CO_OD_entryRecord_t OD_record2120[6] = {
+           {(void*)&CO_OD_RAM.I2CBus.maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.I2CBus.NACKCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.arbitrationLostCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.busErrorCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.timeoutCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.recoveryCount, 0x86, 0x4 },
 };
 
 /*******************************************************************************
@@ -334,6 +383,13 @@ const CO_OD_entry_t CO_OD[CO_OD_NoOfElements] = {
 {0x2107, 0x03, 0xA6,  2, (void*)&CO_OD_RAM.sensors[0]},
 {0x2108, 0x01, 0xA6,  2, (void*)&CO_OD_RAM.temperature[0]},
 {0x2109, 0x01, 0xA6,  2, (void*)&CO_OD_RAM.voltage[0]},
-{0x2110, 0x03, 0x00,  1, (void*)&OD_record2110},
+{0x2110, 0x0D, 0x00,  1, (void*)&OD_record2110},
+{0x2111, 0x04, 0x00,  0, (void*)&OD_record2111},
+{0x2112, 0x00, 0x06,  0, (void*)0},
+{0x2113, 0x0C, 0x00,  0, (void*)&OD_record2113},
+{0x2120, 0x05, 0x00,  0, (void*)&OD_record2120},
+{0x2121, 0x08, 0x06,  1, (void*)&CO_OD_RAM.I2CDeviceAddress[0]},
+{0x2122, 0x08, 0x86,  2, (void*)&CO_OD_RAM.I2CDeviceNACK[0]},
+{0x2123, 0x08, 0x86,  2, (void*)&CO_OD_RAM.I2CDeviceTimeout[0]},
 };
 // clang-format on
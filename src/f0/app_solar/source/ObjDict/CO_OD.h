@@ -89,7 +89,7 @@
 /*******************************************************************************
    OBJECT DICTIONARY
 *******************************************************************************/
-   #define CO_OD_NoOfElements             49
+   #define CO_OD_NoOfElements             56
 
 
 /*******************************************************************************
@@ -154,7 +154,47 @@
                UNSIGNED16     voltage;
                INTEGER16      current;
                UNSIGNED16     power;
+               UNSIGNED32     convergenceTime;
+               UNSIGNED16     ripple;
+               UNSIGNED8      algorithm;
+               UNSIGNED16     stepMin;
+               UNSIGNED16     stepMax;
+               UNSIGNED16     gain;
+               UNSIGNED16     deadband;
+               UNSIGNED16     focvRatio;
+               UNSIGNED16     focvPeriod;
+               UNSIGNED32     sweepPeriod;
                }              OD_solarPanel_t;
+/*2111      */ typedef struct {
+               UNSIGNED8      maxSubIndex;
+               UNSIGNED16     period;
+               UNSIGNED16     jitter;
+               UNSIGNED16     maxJitter;
+               UNSIGNED32     overrunCount;
+               }              OD_MPPTLoop_t;
+/*2113      */ typedef struct {
+               UNSIGNED8      maxSubIndex;
+               UNSIGNED16     window;
+               UNSIGNED16     samples;
+               UNSIGNED16     voltageMin;
+               UNSIGNED16     voltageMax;
+               UNSIGNED16     voltageMean;
+               INTEGER16      currentMin;
+               INTEGER16      currentMax;
+               INTEGER16      currentMean;
+               UNSIGNED16     powerMin;
+               UNSIGNED16     powerMax;
+               UNSIGNED16     powerMean;
+               UNSIGNED16     energy;
+               }              OD_solarStats_t;
+/*2120      */ typedef struct {
+               UNSIGNED8      maxSubIndex;
+               UNSIGNED32     NACKCount;
+               UNSIGNED32     arbitrationLostCount;
+               UNSIGNED32     busErrorCount;
+               UNSIGNED32     timeoutCount;
+               UNSIGNED32     recoveryCount;
+               }              OD_I2CBus_t;
 
 /*******************************************************************************
    TYPE DEFINITIONS FOR OBJECT DICTIONARY INDEXES
@@ -497,6 +537,94 @@
         #define OD_2110_1_solarPanel_voltage                        1
         #define OD_2110_2_solarPanel_current                        2
         #define OD_2110_3_solarPanel_power                          3
+        #define OD_2110_4_solarPanel_convergenceTime                4
+        #define OD_2110_5_solarPanel_ripple                         5
+        #define OD_2110_6_solarPanel_algorithm                      6
+        #define OD_2110_7_solarPanel_stepMin                        7
+        #define OD_2110_8_solarPanel_stepMax                        8
+        #define OD_2110_9_solarPanel_gain                           9
+        #define OD_2110_10_solarPanel_deadband                      10
+        #define OD_2110_11_solarPanel_focvRatio                     11
+        #define OD_2110_12_solarPanel_focvPeriod                    12
+        #define OD_2110_13_solarPanel_sweepPeriod                   13
+
+/*2111 */
+        #define OD_2111_MPPTLoop                                    0x2111
+
+        #define OD_2111_0_MPPTLoop_maxSubIndex                      0
+        #define OD_2111_1_MPPTLoop_period                           1
+        #define OD_2111_2_MPPTLoop_jitter                           2
+        #define OD_2111_3_MPPTLoop_maxJitter                        3
+        #define OD_2111_4_MPPTLoop_overrunCount                     4
+
+/*2112 */
+        #define OD_2112_IVCurve                                     0x2112
+
+/*2113 */
+        #define OD_2113_solarStats                                  0x2113
+
+        #define OD_2113_0_solarStats_maxSubIndex                    0
+        #define OD_2113_1_solarStats_window                         1
+        #define OD_2113_2_solarStats_samples                        2
+        #define OD_2113_3_solarStats_voltageMin                     3
+        #define OD_2113_4_solarStats_voltageMax                     4
+        #define OD_2113_5_solarStats_voltageMean                    5
+        #define OD_2113_6_solarStats_currentMin                     6
+        #define OD_2113_7_solarStats_currentMax                     7
+        #define OD_2113_8_solarStats_currentMean                    8
+        #define OD_2113_9_solarStats_powerMin                       9
+        #define OD_2113_10_solarStats_powerMax                      10
+        #define OD_2113_11_solarStats_powerMean                     11
+        #define OD_2113_12_solarStats_energy                        12
+
+/*2120 */
+        #define OD_2120_I2CBus                                      0x2120
+
+        #define OD_2120_0_I2CBus_maxSubIndex                        0
+        #define OD_2120_1_I2CBus_NACKCount                          1
+        #define OD_2120_2_I2CBus_arbitrationLostCount               2
+        #define OD_2120_3_I2CBus_busErrorCount                      3
+        #define OD_2120_4_I2CBus_timeoutCount                       4
+        #define OD_2120_5_I2CBus_recoveryCount                      5
+
+/*2121 */
+        #define OD_2121_I2CDeviceAddress                            0x2121
+
+        #define OD_2121_0_I2CDeviceAddress_maxSubIndex              0
+        #define OD_2121_1_I2CDeviceAddress_device1                  1
+        #define OD_2121_2_I2CDeviceAddress_device2                  2
+        #define OD_2121_3_I2CDeviceAddress_device3                  3
+        #define OD_2121_4_I2CDeviceAddress_device4                  4
+        #define OD_2121_5_I2CDeviceAddress_device5                  5
+        #define OD_2121_6_I2CDeviceAddress_device6                  6
+        #define OD_2121_7_I2CDeviceAddress_device7                  7
+        #define OD_2121_8_I2CDeviceAddress_device8                  8
+
+/*2122 */
+        #define OD_2122_I2CDeviceNACK                               0x2122
+
+        #define OD_2122_0_I2CDeviceNACK_maxSubIndex                 0
+        #define OD_2122_1_I2CDeviceNACK_device1                     1
+        #define OD_2122_2_I2CDeviceNACK_device2                     2
+        #define OD_2122_3_I2CDeviceNACK_device3                     3
+        #define OD_2122_4_I2CDeviceNACK_device4                     4
+        #define OD_2122_5_I2CDeviceNACK_device5                     5
+        #define OD_2122_6_I2CDeviceNACK_device6                     6
+        #define OD_2122_7_I2CDeviceNACK_device7                     7
+        #define OD_2122_8_I2CDeviceNACK_device8                     8
+
+/*2123 */
+        #define OD_2123_I2CDeviceTimeout                            0x2123
+
+        #define OD_2123_0_I2CDeviceTimeout_maxSubIndex              0
+        #define OD_2123_1_I2CDeviceTimeout_device1                  1
+        #define OD_2123_2_I2CDeviceTimeout_device2                  2
+        #define OD_2123_3_I2CDeviceTimeout_device3                  3
+        #define OD_2123_4_I2CDeviceTimeout_device4                  4
+        #define OD_2123_5_I2CDeviceTimeout_device5                  5
+        #define OD_2123_6_I2CDeviceTimeout_device6                  6
+        #define OD_2123_7_I2CDeviceTimeout_device7                  7
+        #define OD_2123_8_I2CDeviceTimeout_device8                  8
 
 /*******************************************************************************
    STRUCTURES FOR VARIABLES IN DIFFERENT MEMORY LOCATIONS
@@ -552,6 +680,12 @@ struct sCO_OD_RAM{
 /*2108      */ INTEGER16       temperature[1];
 /*2109      */ INTEGER16       voltage[1];
 /*2110      */ OD_solarPanel_t solarPanel;
+/*2111      */ OD_MPPTLoop_t MPPTLoop;
+/*2113      */ OD_solarStats_t solarStats;
+/*2120      */ OD_I2CBus_t I2CBus;
+/*2121      */ UNSIGNED8       I2CDeviceAddress[8];
+/*2122      */ UNSIGNED16      I2CDeviceNACK[8];
+/*2123      */ UNSIGNED16      I2CDeviceTimeout[8];
 
                UNSIGNED32     LastWord;
 };
@@ -716,5 +850,50 @@ extern struct sCO_OD_EEPROM CO_OD_EEPROM;
 /*2110, Data Type: solarPanel_t */
         #define OD_solarPanel                                       CO_OD_RAM.solarPanel
 
+/*2111, Data Type: MPPTLoop_t */
+        #define OD_MPPTLoop                                         CO_OD_RAM.MPPTLoop
+
+/*2113, Data Type: solarStats_t */
+        #define OD_solarStats                                       CO_OD_RAM.solarStats
+
+/*2120, Data Type: I2CBus_t */
+        #define OD_I2CBus                                           CO_OD_RAM.I2CBus
+
+/*2121, Data Type: UNSIGNED8, Array[8] */
+        #define OD_I2CDeviceAddress                                 CO_OD_RAM.I2CDeviceAddress
+        #define ODL_I2CDeviceAddress_arrayLength                    8
+        #define ODA_I2CDeviceAddress_device1                        0
+        #define ODA_I2CDeviceAddress_device2                        1
+        #define ODA_I2CDeviceAddress_device3                        2
+        #define ODA_I2CDeviceAddress_device4                        3
+        #define ODA_I2CDeviceAddress_device5                        4
+        #define ODA_I2CDeviceAddress_device6                        5
+        #define ODA_I2CDeviceAddress_device7                        6
+        #define ODA_I2CDeviceAddress_device8                        7
+
+/*2122, Data Type: UNSIGNED16, Array[8] */
+        #define OD_I2CDeviceNACK                                    CO_OD_RAM.I2CDeviceNACK
+        #define ODL_I2CDeviceNACK_arrayLength                       8
+        #define ODA_I2CDeviceNACK_device1                           0
+        #define ODA_I2CDeviceNACK_device2                           1
+        #define ODA_I2CDeviceNACK_device3                           2
+        #define ODA_I2CDeviceNACK_device4                           3
+        #define ODA_I2CDeviceNACK_device5                           4
+        #define ODA_I2CDeviceNACK_device6                           5
+        #define ODA_I2CDeviceNACK_device7                           6
+        #define ODA_I2CDeviceNACK_device8                           7
+
+/*2123, Data Type: UNSIGNED16, Array[8] */
+        #define OD_I2CDeviceTimeout                                 CO_OD_RAM.I2CDeviceTimeout
+        #define ODL_I2CDeviceTimeout_arrayLength                    8
+        #define ODA_I2CDeviceTimeout_device1                        0
+        #define ODA_I2CDeviceTimeout_device2                        1
+        #define ODA_I2CDeviceTimeout_device3                        2
+        #define ODA_I2CDeviceTimeout_device4                        3
+        #define ODA_I2CDeviceTimeout_device5                        4
+        #define ODA_I2CDeviceTimeout_device6                        5
+        #define ODA_I2CDeviceTimeout_device7                        6
+        #define ODA_I2CDeviceTimeout_device8                        7
+
 #endif
 // clang-format on
@@ -0,0 +1,368 @@
+#include <string.h>
+
+#include "mppt.h"
+
+static uint32_t mppt_abs(int64_t x)
+{
+    if (x < 0)
+        x = -x;
+    return x > UINT32_MAX ? UINT32_MAX : x;
+}
+
+/*
+ * Q16 quotient of num/den without a hardware divider. The denominator is
+ * normalized to [0.5, 1) and its reciprocal refined with Newton-Raphson.
+ */
+int32_t mppt_div_q16(int32_t num, int32_t den)
+{
+    bool neg = (num < 0) != (den < 0);
+    uint32_t n = mppt_abs(num);
+    uint32_t d = mppt_abs(den);
+    uint32_t x, e;
+    uint64_t q;
+    int shift;
+
+    if (d == 0)
+        return neg ? INT32_MIN : INT32_MAX;
+
+    shift = __builtin_clz(d);
+    d <<= shift;
+
+    /* x ~ 1/d in Q30, seeded with 48/17 - 32/17 * d */
+    x = 0xB4B4B4B4U - (uint32_t)(((uint64_t)d * 0x78787878U) >> 32);
+    for (int i = 0; i < 3; i++) {
+        e = ((uint64_t)d * x) >> 32;
+        x = ((uint64_t)x * ((1U << 31) - e)) >> 30;
+    }
+
+    /* n/den in Q16 = n * x >> (46 - shift) */
+    q = ((uint64_t)n * x) >> (46 - shift);
+    if (q > INT32_MAX)
+        q = INT32_MAX;
+    return neg ? -(int32_t)q : (int32_t)q;
+}
+
+typedef struct {
+    void (*reset)(mppt_t *mppt);
+    void (*step)(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v);
+    bool sweep;     /* Hill climbing, benefits from global sweeps */
+} mppt_ops_t;
+
+static void mppt_move(const mppt_cfg_t *cfg, uint32_t *iadj_v, int dir, uint32_t step)
+{
+    if (dir > 0) {
+        *iadj_v = (*iadj_v + step > cfg->iadj_max) ? cfg->iadj_max : *iadj_v + step;
+    } else if (dir < 0) {
+        *iadj_v = (*iadj_v < cfg->iadj_min + step) ? cfg->iadj_min : *iadj_v - step;
+    }
+}
+
+static uint32_t mppt_scale(const mppt_cfg_t *cfg, uint32_t err)
+{
+    uint32_t step = ((uint64_t)err * cfg->gain) >> MPPT_Q;
+
+    if (step < cfg->step_min)
+        step = cfg->step_min;
+    if (step > cfg->step_max)
+        step = cfg->step_max;
+    return step;
+}
+
+/*
+ * Perturb and observe. Keep stepping by step_min in the same direction while
+ * power rises and reverse when it falls.
+ */
+static void mppt_po_reset(mppt_t *mppt)
+{
+    mppt->dir = 1;
+}
+
+static void mppt_po_step(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v)
+{
+    int32_t pwr = (int32_t)volt * curr;
+
+    if (pwr < mppt->prev_pwr)
+        mppt->dir = -mppt->dir;
+    mppt_move(&mppt->cfg, iadj_v, mppt->dir, mppt->cfg.step_min);
+}
+
+/*
+ * Incremental conductance. At the MPP dI/dV = -I/V, which with V > 0 is
+ * I*dV + V*dI = 0, so sign(dP/dV) = sign(I*dV + V*dI) * sign(dV) and
+ * |dP/dV| = |I*dV + V*dI| / |dV|. Raising iadj_v moves the operating point
+ * up the I-V curve.
+ */
+static void mppt_ic_reset(mppt_t *mppt)
+{
+    (void)mppt;
+}
+
+static void mppt_ic_step(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v)
+{
+    const mppt_cfg_t *cfg = &mppt->cfg;
+    int32_t delta_v = (int32_t)volt - mppt->prev_volt;
+    int32_t delta_i = (int32_t)curr - mppt->prev_curr;
+    int64_t g;
+    int dir = 0;
+    uint32_t step = 0;
+    uint32_t slope, mag;
+
+    if (delta_v == 0) {
+        /* Irradiance change at a fixed operating point */
+        if (delta_i != 0) {
+            dir = delta_i > 0 ? 1 : -1;
+            step = cfg->step_min;
+        }
+    } else {
+        g = (int64_t)curr * delta_v + (int64_t)volt * delta_i;
+        mag = mppt_abs(g);
+        slope = mppt_div_q16(mag > INT32_MAX ? INT32_MAX : mag, mppt_abs(delta_v)) >> MPPT_Q;
+        if (slope > cfg->deadband) {
+            dir = ((g > 0) == (delta_v > 0)) ? 1 : -1;
+            step = mppt_scale(cfg, slope);
+        }
+    }
+
+    mppt_move(cfg, iadj_v, dir, step);
+}
+
+/*
+ * Fractional open circuit voltage. Every focv_period iterations the output is
+ * turned all the way down for MPPT_FOCV_HOLD iterations to sample Voc, then
+ * the panel is regulated to focv_ratio * Voc.
+ */
+static void mppt_focv_reset(mppt_t *mppt)
+{
+    mppt->sampling = false;
+    mppt->vref = 0;
+    mppt->tick = 0;
+}
+
+static void mppt_focv_step(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v)
+{
+    const mppt_cfg_t *cfg = &mppt->cfg;
+    int32_t err;
+    uint32_t step;
+    (void)curr;
+
+    if (mppt->sampling) {
+        if (++mppt->tick < MPPT_FOCV_HOLD)
+            return;
+        mppt->vref = ((uint32_t)volt * cfg->focv_ratio) >> MPPT_Q;
+        mppt->sampling = false;
+        mppt->tick = 0;
+        *iadj_v = mppt->saved_iadj;
+        return;
+    }
+
+    if (mppt->vref == 0 || ++mppt->tick >= cfg->focv_period) {
+        mppt->saved_iadj = *iadj_v;
+        mppt->sampling = true;
+        mppt->tick = 0;
+        *iadj_v = cfg->iadj_max;
+        return;
+    }
+
+    err = (int32_t)mppt->vref - volt;
+    if (mppt_abs(err) <= cfg->deadband)
+        return;
+    step = mppt_scale(cfg, mppt_abs(err));
+    mppt_move(cfg, iadj_v, err > 0 ? 1 : -1, step);
+}
+
+static const mppt_ops_t mppt_ops[MPPT_ALGO_COUNT] = {
+    [MPPT_ALGO_PO] = {mppt_po_reset, mppt_po_step, true},
+    [MPPT_ALGO_IC] = {mppt_ic_reset, mppt_ic_step, true},
+    [MPPT_ALGO_FOCV] = {mppt_focv_reset, mppt_focv_step, false},
+};
+
+static void mppt_reset(mppt_t *mppt)
+{
+    mppt->primed = false;
+    mppt->sampling = false;
+    mppt->sweeping = false;
+    mppt->since_sweep = 0;
+    mppt->start = mppt->iter;
+    mppt->settled = false;
+    mppt->run_len = 0;
+    mppt->window = 0;
+    mppt->ripple = 0;
+    mppt_ops[mppt->cfg.algo].reset(mppt);
+}
+
+/* IADJ setpoint in 0.1 mV for a charger output current limit in uA */
+uint32_t calc_iadj(uint32_t i_out)
+{
+    return ((50520000 - i_out * MPPT_RSENSE) / 3200);
+}
+
+void mppt_init(mppt_t *mppt, const mppt_cfg_t *cfg)
+{
+    memset(mppt, 0, sizeof(*mppt));
+    mppt->cfg.algo = MPPT_ALGO_IC;
+    mppt_configure(mppt, cfg);
+    mppt_reset(mppt);
+    mppt->pending = false;
+}
+
+/*
+ * Apply new tuning. An unknown algorithm keeps the active one, the other
+ * parameters still apply. A change of algorithm is deferred to the next
+ * calc_mppt() call so it happens between iterations. Returns false if the
+ * requested algorithm was rejected.
+ */
+bool mppt_configure(mppt_t *mppt, const mppt_cfg_t *cfg)
+{
+    mppt_algo_t algo = mppt->cfg.algo;
+    bool valid = cfg->algo < MPPT_ALGO_COUNT;
+
+    mppt->cfg = *cfg;
+    if (!valid)
+        mppt->cfg.algo = algo;
+    if (mppt->cfg.step_max < mppt->cfg.step_min)
+        mppt->cfg.step_max = mppt->cfg.step_min;
+    if (mppt->cfg.focv_period < MPPT_FOCV_HOLD)
+        mppt->cfg.focv_period = MPPT_FOCV_HOLD;
+    if (mppt->cfg.sweep_period != 0 && mppt->cfg.sweep_period < MPPT_SWEEP_MIN_PERIOD)
+        mppt->cfg.sweep_period = MPPT_SWEEP_MIN_PERIOD;
+    if (mppt->cfg.algo != algo)
+        mppt->pending = true;
+    return valid;
+}
+
+/*
+ * Convergence and ripple, from the measured power only so they do not depend
+ * on how an algorithm steps. The tracker is settled once the power stays in
+ * a band of 1/2^MPPT_SETTLE_SHIFT of the run maximum, but at least
+ * MPPT_SETTLE_FLOOR, for MPPT_SETTLE_COUNT iterations. The convergence time runs from the last reset, or from the
+ * power leaving the band while settled, to the start of the run that
+ * settled. The ripple is the peak to peak power of each MPPT_RIPPLE_WINDOW
+ * iterations.
+ */
+static void mppt_metrics(mppt_t *mppt, int32_t pwr)
+{
+    mppt->iter++;
+
+    if (mppt->run_len > 0) {
+        int32_t lo = pwr < mppt->run_min ? pwr : mppt->run_min;
+        int32_t hi = pwr > mppt->run_max ? pwr : mppt->run_max;
+        uint32_t band = mppt_abs(hi) >> MPPT_SETTLE_SHIFT;
+
+        if ((uint32_t)(hi - lo) > (band > MPPT_SETTLE_FLOOR ? band : MPPT_SETTLE_FLOOR)) {
+            if (mppt->settled)
+                mppt->start = mppt->iter;
+            mppt->settled = false;
+            mppt->run_len = 0;
+        } else {
+            mppt->run_min = lo;
+            mppt->run_max = hi;
+        }
+    }
+    if (mppt->run_len == 0) {
+        mppt->run_start = mppt->iter;
+        mppt->run_min = pwr;
+        mppt->run_max = pwr;
+    }
+    if (mppt->run_len < MPPT_SETTLE_COUNT && ++mppt->run_len == MPPT_SETTLE_COUNT && !mppt->settled) {
+        mppt->settled = true;
+        mppt->conv_time = mppt->run_start - mppt->start;
+    }
+
+    if (mppt->window == 0 || pwr < mppt->pwr_min)
+        mppt->pwr_min = pwr;
+    if (mppt->window == 0 || pwr > mppt->pwr_max)
+        mppt->pwr_max = pwr;
+    if (++mppt->window >= MPPT_RIPPLE_WINDOW) {
+        mppt->ripple = mppt->pwr_max - mppt->pwr_min;
+        mppt->window = 0;
+    }
+}
+
+/*
+ * Global I-V sweep. Hill climbing can lock onto a local maximum when part of
+ * the panel is shaded, so from time to time step the setpoint from open
+ * circuit down across the DAC range, one point every MPPT_SWEEP_SETTLE
+ * iterations, and restart tracking from the best point. The first point
+ * waits longer for the panel to reach open circuit. The sweep ends early once
+ * the panel voltage collapses below 1/8 of open circuit, past that point the
+ * charger asks for more than the panel short circuit current.
+ */
+static void mppt_sweep_start(mppt_t *mppt, uint32_t *iadj_v)
+{
+    const mppt_cfg_t *cfg = &mppt->cfg;
+
+    mppt->saved_iadj = *iadj_v;
+    mppt->sweeping = true;
+    mppt->curve_len = 0;
+    mppt->curve_best = 0;
+    mppt->settle = 0;
+    mppt->sweep_step = (cfg->iadj_max - cfg->iadj_min) / (MPPT_SWEEP_POINTS - 1);
+    *iadj_v = cfg->iadj_max;
+}
+
+static void mppt_sweep(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v)
+{
+    const mppt_cfg_t *cfg = &mppt->cfg;
+    mppt_point_t *pt;
+    int32_t pwr = (int32_t)volt * curr;
+
+    if (++mppt->settle < (mppt->curve_len ? MPPT_SWEEP_SETTLE : 4 * MPPT_SWEEP_SETTLE))
+        return;
+    mppt->settle = 0;
+
+    pt = &mppt->curve[mppt->curve_len];
+    pt->iadj = *iadj_v;
+    pt->volt = volt;
+    pt->curr = curr;
+    if (mppt->curve_len == 0 || pwr > mppt->sweep_pwr) {
+        mppt->curve_best = mppt->curve_len;
+        mppt->sweep_pwr = pwr;
+    }
+    mppt->curve_len++;
+
+    if (mppt->curve_len < MPPT_SWEEP_POINTS &&
+            *iadj_v >= cfg->iadj_min + mppt->sweep_step &&
+            volt >= (mppt->curve[0].volt >> 3)) {
+        *iadj_v -= mppt->sweep_step;
+        return;
+    }
+
+    /* Done, restart tracking from the global maximum */
+    *iadj_v = mppt->curve[mppt->curve_best].iadj;
+    mppt->curve_ready = true;
+    mppt_reset(mppt);
+}
+
+uint32_t calc_mppt(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v)
+{
+    int32_t pwr = (int32_t)volt * curr;
+
+    if (mppt->pending) {
+        /* Switch algorithms, undo a Voc sample or sweep in progress */
+        if (mppt->sampling || mppt->sweeping)
+            *iadj_v = mppt->saved_iadj;
+        mppt_reset(mppt);
+        mppt->pending = false;
+    }
+
+    if (mppt->sweeping) {
+        mppt_sweep(mppt, volt, curr, iadj_v);
+        /* The samples after the jump to the maximum start a fresh track */
+        if (!mppt->sweeping)
+            return *iadj_v;
+    } else if (mppt->cfg.sweep_period != 0 && mppt_ops[mppt->cfg.algo].sweep &&
+            ++mppt->since_sweep >= mppt->cfg.sweep_period) {
+        mppt_sweep_start(mppt, iadj_v);
+    } else if (mppt->primed) {
+        mppt_ops[mppt->cfg.algo].step(mppt, volt, curr, iadj_v);
+        /* Voc samples are not tracking */
+        if (!mppt->sampling)
+            mppt_metrics(mppt, pwr);
+    }
+
+    mppt->primed = true;
+    mppt->prev_volt = volt;
+    mppt->prev_curr = curr;
+    mppt->prev_pwr = pwr;
+    return *iadj_v;
+}
@@ -0,0 +1,148 @@
+#ifndef _MPPT_H_
+#define _MPPT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Iterations the power has to stay within the settle band to count as settled */
+#ifndef MPPT_SETTLE_COUNT
+#define MPPT_SETTLE_COUNT   64
+#endif
+
+/* Settle band as a right shift of the power, 5 is about 3 % */
+#ifndef MPPT_SETTLE_SHIFT
+#define MPPT_SETTLE_SHIFT   5
+#endif
+
+/* Smallest settle band in power units, 1 mW keeps sensor noise in the dark out */
+#ifndef MPPT_SETTLE_FLOOR
+#define MPPT_SETTLE_FLOOR   80000
+#endif
+
+/* Iterations per ripple measurement */
+#ifndef MPPT_RIPPLE_WINDOW
+#define MPPT_RIPPLE_WINDOW  256
+#endif
+
+/* Iterations the output is held off before Voc is sampled */
+#ifndef MPPT_FOCV_HOLD
+#define MPPT_FOCV_HOLD      5
+#endif
+
+/* Charger output current sense resistor in mOhm */
+#ifndef MPPT_RSENSE
+#define MPPT_RSENSE         100
+#endif
+
+/* Points captured by a global I-V sweep */
+#ifndef MPPT_SWEEP_POINTS
+#define MPPT_SWEEP_POINTS   32
+#endif
+
+/* Iterations per sweep point, lets the charger and INA226 catch up */
+#ifndef MPPT_SWEEP_SETTLE
+#define MPPT_SWEEP_SETTLE   2
+#endif
+
+/* Lower bound on the sweep period in iterations */
+#ifndef MPPT_SWEEP_MIN_PERIOD
+#define MPPT_SWEEP_MIN_PERIOD   1000
+#endif
+
+/* Fixed point helpers */
+#define MPPT_Q              16
+#define MPPT_Q_ONE          (1 << MPPT_Q)
+
+/* Tracking algorithms */
+typedef enum {
+    MPPT_ALGO_PO = 0,       /* Perturb and observe */
+    MPPT_ALGO_IC = 1,       /* Incremental conductance */
+    MPPT_ALGO_FOCV = 2,     /* Fractional open circuit voltage */
+    MPPT_ALGO_COUNT
+} mppt_algo_t;
+
+/*
+ * Tracker tuning, all steps are in DAC setpoint units (0.1 mV).
+ * P&O always moves by step_min. IC and FOCV scale the step with gain (Q16)
+ * times |dP/dV| or the voltage error respectively. deadband is in current
+ * LSBs of |dP/dV| for IC and in voltage LSBs for FOCV. focv_ratio is the
+ * Q16 fraction of Voc to track and focv_period the number of iterations
+ * between Voc samples. sweep_period is the number of iterations between
+ * global I-V sweeps for the hill climbing algorithms, 0 disables them.
+ */
+typedef struct {
+    mppt_algo_t algo;
+    uint32_t step_min;
+    uint32_t step_max;
+    int32_t  gain;
+    uint32_t deadband;
+    uint32_t iadj_min;
+    uint32_t iadj_max;
+    uint32_t focv_ratio;
+    uint32_t focv_period;
+    uint32_t sweep_period;
+} mppt_cfg_t;
+
+/* One I-V curve point, raw INA226 VBUS and current with the DAC setpoint */
+typedef struct {
+    uint16_t iadj;
+    uint16_t volt;
+    int16_t  curr;
+} mppt_point_t;
+
+/*
+ * Tracker state. Voltage and current are raw INA226 VBUS and current register
+ * values, power is their product.
+ */
+typedef struct {
+    mppt_cfg_t cfg;
+    bool     pending;
+    bool     primed;
+    uint16_t prev_volt;
+    int16_t  prev_curr;
+    int32_t  prev_pwr;
+    /* Algorithm state */
+    int8_t   dir;
+    bool     sampling;
+    uint16_t vref;
+    uint32_t tick;
+    uint32_t saved_iadj;
+    /* Global sweep */
+    bool     sweeping;
+    bool     curve_ready;
+    uint8_t  curve_len;
+    uint8_t  curve_best;
+    uint8_t  settle;
+    uint32_t since_sweep;
+    uint32_t sweep_step;
+    int32_t  sweep_pwr;
+    mppt_point_t curve[MPPT_SWEEP_POINTS];
+    /* Metrics, in iterations and power units */
+    uint32_t iter;
+    uint32_t start;
+    bool     settled;
+    uint16_t run_len;
+    uint32_t run_start;
+    int32_t  run_min;
+    int32_t  run_max;
+    uint32_t conv_time;
+    int32_t  pwr_min;
+    int32_t  pwr_max;
+    uint16_t window;
+    uint32_t ripple;
+} mppt_t;
+
+void mppt_init(mppt_t *mppt, const mppt_cfg_t *cfg);
+bool mppt_configure(mppt_t *mppt, const mppt_cfg_t *cfg);
+int32_t mppt_div_q16(int32_t num, int32_t den);
+uint32_t calc_iadj(uint32_t i_out);
+uint32_t calc_mppt(mppt_t *mppt, uint16_t volt, int16_t curr, uint32_t *iadj_v);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
@@ -1,12 +1,42 @@
+#include <string.h>
+
 #include "solar.h"
 #include "ina226.h"
 #include "max580x.h"
+#include "i2c_bus.h"
+#include "mppt.h"
+#include "stats.h"
 #include "CANopen.h"
+#include "oresat.h"
 
 #define CURR_LSB    10  /* 10uA/bit */
 #define RSENSE      100 /* 0.1 ohm  */
-#define SLEEP_MS    1
-#define STEP_SIZE   5
+#define IADJ_MAX    20475   /* DAC full scale with the 2.048 V reference */
+
+#define LOOP_TIMER_FREQ     100000  /* 10 us per tick */
+#define LOOP_TICK_US        10
+#define LOOP_PERIOD_MIN     1000    /* us, the I2C transfers and a conversion */
+#define LOOP_CONV_TIME      (332 + 332) /* us, VSHCT + VBUSCT of ina226config */
+#define LOOP_TIMEOUT        TIME_MS2I(100)
+#define SWEEP_PERIOD_MAX    3600000 /* ms, keeps the conversion in 32 bits */
+#define STATS_WINDOW_MIN    100     /* ms */
+#define STATS_WINDOW_MAX    20000   /* ms, keeps the mJ energy of a 3.2 W panel in 16 bits */
+#define STATS_TPDO          2       /* TPDO 3, mapped to the solar stats record */
+
+#if LOOP_PERIOD_MIN <= LOOP_CONV_TIME
+#error "LOOP_PERIOD_MIN must leave a conversion time between ticks"
+#endif
+
+/* IV curve domain: uptime, point count, best index, then 6 bytes per point */
+#define IVCURVE_HDR_SIZE    6
+#define IVCURVE_SIZE        (IVCURVE_HDR_SIZE + MPPT_SWEEP_POINTS * 6)
+
+/* MPPT power units (1.25 mV * CURR_LSB = 12.5 nW) to 0.01 mW */
+#define MPPT_PWR_TO_OD(p)   ((p) / 800)
+/* MPPT power units to the INA226 power register scaled by CURR_LSB * 25, uW */
+#define MPPT_PWR_TO_UW(p)   ((p) / 80)
+/* 0.1 % units to Q16, 67109 / 1024 ~ 65536 / 1000 */
+#define PERMILLE_TO_Q16(r)  (((r) * 67109) >> 10)
 
 static const I2CConfig i2cconfig = {
     STM32_TIMINGR_PRESC(0xBU) |
@@ -16,12 +46,38 @@ static const I2CConfig i2cconfig = {
     0
 };
 
+/* Publish the I2C error counters */
+static void i2c_bus_update(const i2c_bus_t *bus)
+{
+    CO_LOCK_OD();
+    OD_I2CBus.NACKCount = bus->stats.nack;
+    OD_I2CBus.arbitrationLostCount = bus->stats.arb_lost;
+    OD_I2CBus.busErrorCount = bus->stats.bus_error;
+    OD_I2CBus.timeoutCount = bus->stats.timeout;
+    OD_I2CBus.recoveryCount = bus->stats.recovery;
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES && i < ODL_I2CDeviceAddress_arrayLength; i++) {
+        OD_I2CDeviceAddress[i] = bus->dev[i].addr;
+        OD_I2CDeviceNACK[i] = bus->dev[i].nack;
+        OD_I2CDeviceTimeout[i] = bus->dev[i].timeout;
+    }
+    CO_UNLOCK_OD();
+}
+
+static const i2c_bus_config_t i2cbusconfig = {
+    &I2CD1,
+    PAL_LINE(GPIOB, GPIOB_I2C1_SCL),
+    PAL_LINE(GPIOB, GPIOB_I2C1_SDA),
+    PAL_MODE_ALTERNATE(1) | PAL_STM32_OTYPE_OPENDRAIN | PAL_STM32_OSPEED_HIGHEST |
+        PAL_STM32_PUPDR_PULLUP,
+    i2c_bus_update
+};
+
 static const INA226Config ina226config = {
     &I2CD1,
     &i2cconfig,
     INA226_SADDR,
-    INA226_CONFIG_MODE_SHUNT_VBUS | INA226_CONFIG_MODE_CONT |
-    INA226_CONFIG_VSHCT_1100US | INA226_CONFIG_VBUSCT_1100US |
+    INA226_CONFIG_MODE_SHUNT_VBUS |
+    INA226_CONFIG_VSHCT_332US | INA226_CONFIG_VBUSCT_332US |
     INA226_CONFIG_AVG_1,
     (5120000/(RSENSE*CURR_LSB)),
     CURR_LSB
@@ -37,77 +93,295 @@ static const MAX580XConfig max580xconfig = {
     MAX580X_DEFAULT_POR
 };
 
+static void loop_cb(GPTDriver *gptp);
+
+static const GPTConfig loopconfig = {
+    LOOP_TIMER_FREQ,
+    loop_cb,
+    0,
+    0
+};
+
+static thread_reference_t loop_trp = NULL;
+static uint32_t loop_overruns;
+static uint8_t ivcurve[IVCURVE_SIZE];
+static uint32_t ivcurve_len;
+
+static i2c_bus_t i2cbus;
+static mppt_t mppt;
+static stats_t stats;
+static stats_window_t stats_win;
 static MAX580XDriver max580xdev;
 static INA226Driver ina226dev;
 
-uint32_t calc_iadj(uint32_t i_out)
+/* OD tuning the derived MPPT iteration counts were last computed from */
+static struct {
+    uint32_t period;
+    uint16_t focv_period;
+    uint16_t focv_ratio;
+    uint32_t sweep_period;
+} mppt_od;
+
+/* Loop timer tick, wakes the solar thread or counts an overrun if it is busy */
+static void loop_cb(GPTDriver *gptp)
 {
-    return ((50520000 - i_out * RSENSE) / 3200);
+    (void)gptp;
+
+    chSysLockFromISR();
+    if (loop_trp == NULL)
+        loop_overruns++;
+    else
+        chThdResumeI(&loop_trp, MSG_OK);
+    chSysUnlockFromISR();
 }
 
-uint32_t calc_mppt(uint16_t volt, int16_t curr, uint16_t pwr, uint32_t *iadj_v)
+/*
+ * Snapshot the MPPT tuning from the OD, it may be written by SDO at any time.
+ * The values that take a division are only recomputed when their OD entries
+ * or the period change, the M0 has no divider.
+ */
+static void mppt_cfg_from_od(mppt_cfg_t *cfg, uint32_t period)
 {
-    /* The values from the previous iteration of the loop */
-    static uint16_t prev_volt = 0;
-    static int16_t  prev_curr = 0;
-    static uint16_t prev_pwr = 0;
-    int16_t delta_v = volt - prev_volt;
-    int16_t delta_i = curr - prev_curr;
-    int16_t delta_p = pwr  - prev_pwr;
-    prev_volt = volt;
-    prev_curr = curr;
-    prev_pwr  = pwr;
-
-    /* Start IC MPPT Algorithm */
-    if (delta_v == 0) {
-        if (delta_i != 0) {
-            if (delta_i > 0) {
-                *iadj_v += STEP_SIZE;
-            } else {
-                *iadj_v -= STEP_SIZE;
-            }
-        }
-    } else {
-        if (delta_p/delta_v != 0) {
-            if (delta_p/delta_v > 0) {
-                *iadj_v += STEP_SIZE;
-            } else {
-                *iadj_v -= STEP_SIZE;
-            }
-        }
+    uint16_t focv, ratio;
+    uint32_t sweep;
+
+    CO_LOCK_OD();
+    cfg->algo = OD_solarPanel.algorithm;
+    cfg->step_min = OD_solarPanel.stepMin;
+    cfg->step_max = OD_solarPanel.stepMax;
+    cfg->gain = OD_solarPanel.gain;
+    cfg->deadband = OD_solarPanel.deadband;
+    ratio = OD_solarPanel.focvRatio;
+    focv = OD_solarPanel.focvPeriod;
+    sweep = OD_solarPanel.sweepPeriod;
+    CO_UNLOCK_OD();
+
+    if (period != mppt_od.period || focv != mppt_od.focv_period ||
+            ratio != mppt_od.focv_ratio || sweep != mppt_od.sweep_period) {
+        mppt_od.period = period;
+        mppt_od.focv_period = focv;
+        mppt_od.focv_ratio = ratio;
+        mppt_od.sweep_period = sweep;
+
+        if (sweep > SWEEP_PERIOD_MAX)
+            sweep = SWEEP_PERIOD_MAX;
+        cfg->focv_period = (uint32_t)focv * 1000 / period;
+        cfg->sweep_period = sweep * 1000 / period;
+        cfg->focv_ratio = PERMILLE_TO_Q16(ratio > 1000 ? 1000 : ratio);
     }
-    /* End IC MPPT Algorithm */
 
-    return *iadj_v;
+    cfg->iadj_min = 0;
+    cfg->iadj_max = IADJ_MAX;
 }
 
-/* Main solar management thread */
-THD_WORKING_AREA(solar_wa, 0x100);
+static uint8_t *put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+/* Copy a finished sweep into the IV curve domain */
+static void ivcurve_publish(const mppt_t *mppt)
+{
+    uint32_t now = TIME_I2MS(chVTGetSystemTimeX());
+    uint8_t *p = ivcurve;
+
+    CO_LOCK_OD();
+    p = put_le16(p, now & 0xFFFF);
+    p = put_le16(p, now >> 16);
+    *p++ = mppt->curve_len;
+    *p++ = mppt->curve_best;
+    for (int i = 0; i < mppt->curve_len; i++) {
+        p = put_le16(p, mppt->curve[i].iadj);
+        p = put_le16(p, mppt->curve[i].volt);
+        p = put_le16(p, mppt->curve[i].curr);
+    }
+    ivcurve_len = p - ivcurve;
+    CO_UNLOCK_OD();
+}
+
+static uint32_t ivcurve_size(void *arg)
+{
+    (void)arg;
+    return ivcurve_len;
+}
+
+/* Streamed one SDO block at a time, called with the OD locked */
+static uint32_t ivcurve_read(void *arg, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    (void)arg;
+
+    if (offset >= ivcurve_len)
+        return 0;
+    if (len > ivcurve_len - offset)
+        len = ivcurve_len - offset;
+    memcpy(buf, &ivcurve[offset], len);
+
+    return len;
+}
+
+const sdo_stream_t ivcurve_stream = {
+    ivcurve_size,
+    ivcurve_read,
+    NULL,
+    NULL
+};
+
+/* Samples per statistics window, the OD window is in ms */
+static uint16_t stats_len(uint32_t window, uint32_t period)
+{
+    uint32_t len;
+
+    if (window < STATS_WINDOW_MIN)
+        window = STATS_WINDOW_MIN;
+    else if (window > STATS_WINDOW_MAX)
+        window = STATS_WINDOW_MAX;
+    len = window * 1000 / period;
+
+    return len > UINT16_MAX ? UINT16_MAX : len;
+}
+
+/* Publish a completed window and queue its TPDO */
+static void stats_publish(const stats_window_t *w)
+{
+    CO_LOCK_OD();
+    OD_solarStats.samples = w->samples;
+    OD_solarStats.voltageMin = w->volt_min;
+    OD_solarStats.voltageMax = w->volt_max;
+    OD_solarStats.voltageMean = w->volt_mean;
+    OD_solarStats.currentMin = w->curr_min;
+    OD_solarStats.currentMax = w->curr_max;
+    OD_solarStats.currentMean = w->curr_mean;
+    OD_solarStats.powerMin = w->pwr_min;
+    OD_solarStats.powerMax = w->pwr_max;
+    OD_solarStats.powerMean = w->pwr_mean;
+    OD_solarStats.energy = w->energy;
+    if (CO != NULL) {
+        CO->TPDO[STATS_TPDO]->sendRequest = 1;
+        chEvtBroadcastI(&cos_event);
+    }
+    CO_UNLOCK_OD();
+}
+
+/*
+ * Main solar management thread. The loop runs I2C bus recovery, 64 bit Q16
+ * math and keeps an mppt_cfg_t.
+ */
+THD_WORKING_AREA(solar_wa, 0x200);
 THD_FUNCTION(solar, arg)
 {
     (void)arg;
     uint32_t iadj_v = 15000;
+    mppt_cfg_t cfg;
+    uint16_t volt;
+    int16_t curr;
+    uint32_t period = OD_MPPTLoop.period;
+    uint16_t window = OD_solarStats.window;
+    uint32_t conv_time = 0;
+    uint32_t lat, prev_lat = 0, jitter;
+    uint16_t len;
+    bool resize;
+    msg_t msg;
 
     /* Start up drivers for I2C devices */
+    i2c_bus_register(&i2cbus, &i2cbusconfig);
     ina226Start(&ina226dev, &ina226config);
     max580xStart(&max580xdev, &max580xconfig);
     palSetLine(LINE_LED);
 
+    if (period < LOOP_PERIOD_MIN)
+        period = LOOP_PERIOD_MIN;
+    mppt_cfg_from_od(&cfg, period);
+    mppt_init(&mppt, &cfg);
+    stats_init(&stats, stats_len(window, period));
+
+    /* Prime the pipeline with a sample of the initial setpoint */
     max580xWriteVoltage(&max580xdev, MAX580X_CODE_LOAD, iadj_v);
+    ina226Trigger(&ina226dev);
+
+    gptStart(&GPTD14, &loopconfig);
+    gptStartContinuous(&GPTD14, period / LOOP_TICK_US);
     while (!chThdShouldTerminateX()) {
-        chThdSleepMilliseconds(SLEEP_MS);
+        chSysLock();
+        msg = chThdSuspendTimeoutS(&loop_trp, LOOP_TIMEOUT);
+        chSysUnlock();
+        if (msg != MSG_OK)
+            continue;
+
+        /* The counter restarts on every tick, so it reads the wakeup latency */
+        lat = gptGetCounterX(&GPTD14) * LOOP_TICK_US;
+        jitter = lat > prev_lat ? lat - prev_lat : prev_lat - lat;
+        prev_lat = lat;
 
-        /* Get present values */
-        OD_solarPanel.voltage = ina226ReadVBUS(&ina226dev);
-        OD_solarPanel.current = ina226ReadCurrent(&ina226dev);
-        OD_solarPanel.power = ina226ReadPower(&ina226dev);
+        /*
+         * Get the sample converted since the last tick, it belongs to the
+         * setpoint written then. The tracker works on raw register values.
+         */
+        volt = ina226ReadRaw(&ina226dev, INA226_AD_VBUS);
+        curr = ina226ReadRaw(&ina226dev, INA226_AD_CURRENT);
 
-        /* Calculate iadj */
-        calc_mppt(OD_solarPanel.voltage, OD_solarPanel.current, OD_solarPanel.power, &iadj_v);
+        /* Pick up tuning changes, an algorithm switch applies on the next step */
+        mppt_cfg_from_od(&cfg, period);
+        if (!mppt_configure(&mppt, &cfg)) {
+            CO_LOCK_OD();
+            OD_solarPanel.algorithm = mppt.cfg.algo;
+            CO_UNLOCK_OD();
+        }
 
-        /* Write new iadj value */
+        /*
+         * Calculate iadj for the next period, actuate it and start its
+         * conversion. The conversion runs while the rest of this period is
+         * spent on bookkeeping and waiting for the next tick.
+         */
+        calc_mppt(&mppt, volt, curr, &iadj_v);
         max580xWriteVoltage(&max580xdev, MAX580X_CODE_LOAD, iadj_v);
+        ina226Trigger(&ina226dev);
+        if (mppt.curve_ready) {
+            ivcurve_publish(&mppt);
+            mppt.curve_ready = false;
+        }
+
+        if (stats_add(&stats, volt, curr, period, &stats_win))
+            stats_publish(&stats_win);
+
+        OD_solarPanel.voltage = volt * 125;
+        OD_solarPanel.current = curr * CURR_LSB;
+        OD_solarPanel.power = MPPT_PWR_TO_UW((int32_t)volt * curr);
+        if (mppt.conv_time != conv_time) {
+            conv_time = mppt.conv_time;
+            OD_solarPanel.convergenceTime = conv_time * period / 1000;
+        }
+        OD_solarPanel.ripple = MPPT_PWR_TO_OD(mppt.ripple) > UINT16_MAX ?
+            UINT16_MAX : MPPT_PWR_TO_OD(mppt.ripple);
+
+        resize = false;
+        CO_LOCK_OD();
+        OD_MPPTLoop.jitter = jitter > UINT16_MAX ? UINT16_MAX : jitter;
+        if (OD_MPPTLoop.jitter > OD_MPPTLoop.maxJitter)
+            OD_MPPTLoop.maxJitter = OD_MPPTLoop.jitter;
+        OD_MPPTLoop.overrunCount = loop_overruns;
+        if (OD_MPPTLoop.period != period && OD_MPPTLoop.period >= LOOP_PERIOD_MIN) {
+            period = OD_MPPTLoop.period;
+            gptChangeIntervalI(&GPTD14, period / LOOP_TICK_US);
+            resize = true;
+        }
+        OD_MPPTLoop.period = period;
+        if (OD_solarStats.window != window) {
+            window = OD_solarStats.window;
+            resize = true;
+        }
+        CO_UNLOCK_OD();
+
+        /* A new window length restarts the current window */
+        if (resize) {
+            len = stats_len(window, period);
+            if (len != stats.len)
+                stats_init(&stats, len);
+        }
     }
+    gptStopTimer(&GPTD14);
+    gptStop(&GPTD14);
 
     /* Stop drivers for I2C devices */
     max580xStop(&max580xdev);
@@ -3,13 +3,18 @@
 
 #include "ch.h"
 #include "hal.h"
+#include "CANopen.h"
+#include "sdo_stream.h"
 
 #define MAX5805_SADDR       0x18
 #define INA226_SADDR        0x40
 #define TMP101_SADDR        0x4A
 
 /* Example blinker thread prototypes */
-extern THD_WORKING_AREA(solar_wa, 0x100);
+extern THD_WORKING_AREA(solar_wa, 0x200);
 extern THD_FUNCTION(solar, arg);
 
+/* IV curve OD domain access */
+extern const sdo_stream_t ivcurve_stream;
+
 #endif
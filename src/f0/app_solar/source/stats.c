@@ -0,0 +1,79 @@
+#include "stats.h"
+
+/* INA226 raw units: VBUS 1.25 mV, current 10 uA, so power is 12.5 nW */
+#define VOLT_TO_MV(v)       ((v) * 5 / 4)
+#define CURR_TO_MA(c)       ((c) / 100)
+#define PWR_TO_MW(p)        ((p) / 80000)
+/* Power sum times period in us, 12.5 nW * 1 us = 1.25e-11 mJ */
+#define PWR_US_TO_MJ(e)     ((e) / 80000000000LL)
+
+static uint16_t clamp_u16(int64_t x)
+{
+    return x < 0 ? 0 : (x > UINT16_MAX ? UINT16_MAX : x);
+}
+
+static void stats_clear(stats_t *st)
+{
+    st->n = 0;
+    st->volt_min = UINT16_MAX;
+    st->volt_max = 0;
+    st->curr_min = INT16_MAX;
+    st->curr_max = INT16_MIN;
+    st->pwr_min = INT32_MAX;
+    st->pwr_max = INT32_MIN;
+    st->volt_sum = 0;
+    st->curr_sum = 0;
+    st->pwr_sum = 0;
+}
+
+void stats_init(stats_t *st, uint16_t len)
+{
+    st->len = len ? len : 1;
+    stats_clear(st);
+}
+
+/*
+ * Fold one sample into the window. Returns true and fills out when the
+ * window completes, the next sample starts a new window.
+ */
+bool stats_add(stats_t *st, uint16_t volt, int16_t curr, uint32_t period,
+               stats_window_t *out)
+{
+    int32_t pwr = (int32_t)volt * curr;
+    uint16_t n;
+
+    if (volt < st->volt_min)
+        st->volt_min = volt;
+    if (volt > st->volt_max)
+        st->volt_max = volt;
+    if (curr < st->curr_min)
+        st->curr_min = curr;
+    if (curr > st->curr_max)
+        st->curr_max = curr;
+    if (pwr < st->pwr_min)
+        st->pwr_min = pwr;
+    if (pwr > st->pwr_max)
+        st->pwr_max = pwr;
+    st->volt_sum += volt;
+    st->curr_sum += curr;
+    st->pwr_sum += pwr;
+
+    if (++st->n < st->len)
+        return false;
+
+    n = st->n;
+    out->samples = n;
+    out->volt_min = VOLT_TO_MV(st->volt_min);
+    out->volt_max = VOLT_TO_MV(st->volt_max);
+    out->volt_mean = VOLT_TO_MV(st->volt_sum / n);
+    out->curr_min = CURR_TO_MA(st->curr_min);
+    out->curr_max = CURR_TO_MA(st->curr_max);
+    out->curr_mean = CURR_TO_MA(st->curr_sum / n);
+    out->pwr_min = clamp_u16(PWR_TO_MW(st->pwr_min));
+    out->pwr_max = clamp_u16(PWR_TO_MW(st->pwr_max));
+    out->pwr_mean = clamp_u16(PWR_TO_MW(st->pwr_sum / n));
+    out->energy = clamp_u16(PWR_US_TO_MJ(st->pwr_sum * period));
+    stats_clear(st);
+
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Running statistics of one control loop window, in raw INA226 units */
+typedef struct {
+    uint16_t n;             /* samples so far */
+    uint16_t len;           /* samples per window */
+    uint16_t volt_min;
+    uint16_t volt_max;
+    int16_t curr_min;
+    int16_t curr_max;
+    int32_t pwr_min;
+    int32_t pwr_max;
+    uint32_t volt_sum;
+    int32_t curr_sum;
+    int64_t pwr_sum;
+} stats_t;
+
+/* Results of a completed window in engineering units */
+typedef struct {
+    uint16_t samples;
+    uint16_t volt_min;      /* mV */
+    uint16_t volt_max;
+    uint16_t volt_mean;
+    int16_t curr_min;       /* mA */
+    int16_t curr_max;
+    int16_t curr_mean;
+    uint16_t pwr_min;       /* mW */
+    uint16_t pwr_max;
+    uint16_t pwr_mean;
+    uint16_t energy;        /* mJ, saturates at 65.5 J */
+} stats_window_t;
+
+void stats_init(stats_t *st, uint16_t len);
+bool stats_add(stats_t *st, uint16_t volt, int16_t curr, uint32_t period,
+               stats_window_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -22,12 +22,81 @@
 /* Project header files */
 #include "oresat.h"
 #include "opd.h"
+#include "max7310.h"
+#include "i2c_bus.h"
 #include "command.h"
+#include "CO_master.h"
+#include "od_cache.h"
+#include "hb_monitor.h"
+#include "lss_scan.h"
+#include "can_log.h"
 
 /*
  * Workers
  */
 static worker_t shell_worker;
+static worker_t od_cache_worker;
+static worker_t hb_worker;
+static worker_t lss_worker;
+static worker_t can_log_worker;
+static worker_t sdo_worker;
+
+/*
+ * Publish the I2C error counters.
+ */
+static void i2c_bus_update(const i2c_bus_t *bus)
+{
+    CO_LOCK_OD();
+    OD_I2CBus.NACKCount = bus->stats.nack;
+    OD_I2CBus.arbitrationLostCount = bus->stats.arb_lost;
+    OD_I2CBus.busErrorCount = bus->stats.bus_error;
+    OD_I2CBus.timeoutCount = bus->stats.timeout;
+    OD_I2CBus.recoveryCount = bus->stats.recovery;
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES && i < ODL_I2CDeviceAddress_arrayLength; i++) {
+        OD_I2CDeviceAddress[i] = bus->dev[i].addr;
+        OD_I2CDeviceNACK[i] = bus->dev[i].nack;
+        OD_I2CDeviceTimeout[i] = bus->dev[i].timeout;
+    }
+    CO_UNLOCK_OD();
+}
+
+/*
+ * I2C bus supervision.
+ */
+static i2c_bus_t i2cbus;
+static const i2c_bus_config_t i2cbusconfig = {
+    &I2CD1,
+    PAL_LINE(GPIOB, GPIOB_I2C1_SCL),
+    PAL_LINE(GPIOB, GPIOB_I2C1_SDA),
+    PAL_MODE_ALTERNATE(4) | PAL_STM32_OTYPE_OPENDRAIN | PAL_STM32_OSPEED_HIGHEST |
+        PAL_STM32_PUPDR_PULLUP,
+    i2c_bus_update
+};
+
+/*
+ * OPD fault reporting.
+ */
+#define CO_EM_OPD_TRIPPED   CO_EM_MANUFACTURER_START
+
+static uint64_t opd_tripped;
+
+static void opd_fault(i2caddr_t addr, bool tripped)
+{
+    if (tripped) {
+        CO_LOCK_OD();
+        OD_OPDFaultCount[addr - MAX7310_MIN_ADDR]++;
+        OD_OPDTripTime[addr - MAX7310_MIN_ADDR] = TIME_I2MS(chVTGetSystemTime());
+        CO_UNLOCK_OD();
+        opd_tripped |= ((uint64_t)1U) << addr;
+        if (CO != NULL)
+            CO_errorReport(CO->em, CO_EM_OPD_TRIPPED, CO_EMC_CURRENT_OUTPUT, addr);
+    } else {
+        opd_tripped &= ~(((uint64_t)1U) << addr);
+        /* Clear the error bit once every breaker is back, so the next trip emits again */
+        if (opd_tripped == 0 && CO != NULL)
+            CO_errorReset(CO->em, CO_EM_OPD_TRIPPED, 0);
+    }
+}
 
 /*
  * Working area for driver.
@@ -56,8 +125,26 @@ static void app_init(void)
     /* App initialization */
     init_worker(&shell_worker, "Command Shell", cmd_wa, sizeof(cmd_wa), NORMALPRIO, cmd, NULL);
     reg_worker(&shell_worker);
+    init_worker(&od_cache_worker, "OD Cache", od_cache_wa, sizeof(od_cache_wa), NORMALPRIO, od_cache, NULL);
+    reg_worker(&od_cache_worker);
+    init_worker(&hb_worker, "HB Monitor", hb_monitor_wa, sizeof(hb_monitor_wa), NORMALPRIO, hb_monitor, NULL);
+    reg_worker(&hb_worker);
+    init_worker(&lss_worker, "LSS Scan", lss_scan_wa, sizeof(lss_scan_wa), NORMALPRIO, lss_scan, NULL);
+    reg_worker(&lss_worker);
+    init_worker(&can_log_worker, "CAN Logger", can_log_wa, sizeof(can_log_wa), LOWPRIO, can_log, NULL);
+    reg_worker(&can_log_worker);
+    /* Registered last so it stops first and fails the shell's pending transfers */
+    init_worker(&sdo_worker, "SDO Client Pool", sdo_pool_wa, sizeof(sdo_pool_wa), NORMALPRIO, sdo_pool, NULL);
+    reg_worker(&sdo_worker);
+
+    /* Snoop TPDOs and heartbeats of other nodes and log all traffic, before the CAN module is set up */
+    od_cache_init();
+    hb_monitor_init();
+    can_log_init();
 
     /* Initialize OPD */
+    i2c_bus_register(&i2cbus, &i2cbusconfig);
+    opd_set_fault_cb(opd_fault);
     opd_init();
     opd_start();
 
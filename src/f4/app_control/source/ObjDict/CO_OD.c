@@ -119,7 +119,7 @@ struct sCO_OD_RAM CO_OD_RAM = {
 /*1003*/ {0, 0, 0, 0, 0, 0, 0, 0},
 /*1010*/ {0x00000003},
 /*1011*/ {0x00000001},
-/*1280*/ {{0x3L, 0x0000L, 0x0000L, 0x0L}},
+/*1280*/ {{0x3L, 0x0000L, 0x0000L, 0x0L}, {0x3L, 0x0000L, 0x0000L, 0x0L}, {0x3L, 0x0000L, 0x0000L, 0x0L}, {0x3L, 0x0000L, 0x0000L, 0x0L}},
 /*1F81*/ {0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
 /*1F82*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
 /*1F89*/ 0x0000L,
@@ -131,6 +131,17 @@ struct sCO_OD_RAM CO_OD_RAM = {
 /*2107*/ {0x00, 0x00, 0x00},
 /*2108*/ {0x00},
 /*2109*/ {0x00},
+/*2110*/ {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+/*2111*/ {0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
+/*2120*/ {0x5L, 0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
+/*2121*/ {0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L, 0x0L},
+/*2122*/ {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+/*2123*/ {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+/*2130*/ {0x0000L, 0x0000L, 0x0000L, 0x0000L},
+/*2131*/ {0x0000L, 0x0000L, 0x0000L, 0x0000L},
+/*2132*/ 0x5DC,
+/*2133*/ {0x0000L, 0x0000L},
+/*2140*/ {0x0000L, 0x0000L, 0x0000L, 0x0000L, 0x0000L},
 
            CO_OD_FIRST_LAST_WORD,
 };
@@ -173,6 +184,27 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
            {(void*)&CO_OD_RAM.SDOClientParameter[0].nodeIDOfTheSDOServer, 0x0E, 0x1 },
 };
 
+/*0x1281*/ const CO_OD_entryRecord_t OD_record1281[4] = {
+           {(void*)&CO_OD_RAM.SDOClientParameter[1].maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[1].COB_IDClientToServer, 0xBE, 0x4 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[1].COB_IDServerToClient, 0xBE, 0x4 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[1].nodeIDOfTheSDOServer, 0x0E, 0x1 },
+};
+
+/*0x1282*/ const CO_OD_entryRecord_t OD_record1282[4] = {
+           {(void*)&CO_OD_RAM.SDOClientParameter[2].maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[2].COB_IDClientToServer, 0xBE, 0x4 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[2].COB_IDServerToClient, 0xBE, 0x4 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[2].nodeIDOfTheSDOServer, 0x0E, 0x1 },
+};
+
+/*0x1283*/ const CO_OD_entryRecord_t OD_record1283[4] = {
+           {(void*)&CO_OD_RAM.SDOClientParameter[3].maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[3].COB_IDClientToServer, 0xBE, 0x4 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[3].COB_IDServerToClient, 0xBE, 0x4 },
+           {(void*)&CO_OD_RAM.SDOClientParameter[3].nodeIDOfTheSDOServer, 0x0E, 0x1 },
+};
+
 /*0x1400*/ const CO_OD_entryRecord_t OD_record1400[3] = {
            {(void*)&CO_OD_ROM.RPDOCommunicationParameter[0].maxSubIndex, 0x05, 0x1 },
            {(void*)&CO_OD_ROM.RPDOCommunicationParameter[0].COB_IDUsedByRPDO, 0x8D, 0x4 },
@@ -813,6 +845,15 @@ struct sCO_OD_EEPROM CO_OD_EEPROM = {
            {(void*)&CO_OD_ROM.TPDOMappingParameter[15].mappedObject8, 0x8D, 0x4 },
 };
 
+/*0x2120*/ const CO_OD_entryRecord_t OD_record2120[6] = {
+           {(void*)&CO_OD_RAM.I2CBus.maxSubIndex, 0x06, 0x1 },
+           {(void*)&CO_OD_RAM.I2CBus.NACKCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.arbitrationLostCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.busErrorCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.timeoutCount, 0x86, 0x4 },
+           {(void*)&CO_OD_RAM.I2CBus.recoveryCount, 0x86, 0x4 },
+};
+
 /*******************************************************************************
    OBJECT DICTIONARY
 *******************************************************************************/
@@ -838,6 +879,9 @@ const CO_OD_entry_t CO_OD[CO_OD_NoOfElements] = {
 {0x1029, 0x06, 0x0D,  1, (void*)&CO_OD_ROM.errorBehavior[0]},
 {0x1200, 0x02, 0x00,  0, (void*)&OD_record1200},
 {0x1280, 0x03, 0x00,  0, (void*)&OD_record1280},
+{0x1281, 0x03, 0x00,  0, (void*)&OD_record1281},
+{0x1282, 0x03, 0x00,  0, (void*)&OD_record1282},
+{0x1283, 0x03, 0x00,  0, (void*)&OD_record1283},
 {0x1400, 0x02, 0x00,  0, (void*)&OD_record1400},
 {0x1401, 0x02, 0x00,  0, (void*)&OD_record1401},
 {0x1402, 0x02, 0x00,  0, (void*)&OD_record1402},
@@ -917,5 +961,16 @@ const CO_OD_entry_t CO_OD[CO_OD_NoOfElements] = {
 {0x2107, 0x03, 0xA6,  2, (void*)&CO_OD_RAM.sensors[0]},
 {0x2108, 0x01, 0xA6,  2, (void*)&CO_OD_RAM.temperature[0]},
 {0x2109, 0x01, 0xA6,  2, (void*)&CO_OD_RAM.voltage[0]},
+{0x2110, 0x38, 0xA6,  2, (void*)&CO_OD_RAM.OPDFaultCount[0]},
+{0x2111, 0x38, 0xA6,  4, (void*)&CO_OD_RAM.OPDTripTime[0]},
+{0x2120, 0x05, 0x00,  0, (void*)&OD_record2120},
+{0x2121, 0x08, 0x06,  1, (void*)&CO_OD_RAM.I2CDeviceAddress[0]},
+{0x2122, 0x08, 0x86,  2, (void*)&CO_OD_RAM.I2CDeviceNACK[0]},
+{0x2123, 0x08, 0x86,  2, (void*)&CO_OD_RAM.I2CDeviceTimeout[0]},
+{0x2130, 0x04, 0xA6,  4, (void*)&CO_OD_RAM.nodeAlive[0]},
+{0x2131, 0x04, 0xA6,  4, (void*)&CO_OD_RAM.nodeOperational[0]},
+{0x2132, 0x00, 0x8E,  2, (void*)&CO_OD_RAM.heartbeatTimeout},
+{0x2133, 0x02, 0xA6,  4, (void*)&CO_OD_RAM.LSSScan[0]},
+{0x2140, 0x05, 0xA6,  4, (void*)&CO_OD_RAM.CANLog[0]},
 };
 // clang-format on
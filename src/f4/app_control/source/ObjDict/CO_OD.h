@@ -77,9 +77,9 @@
   #define CO_NO_EMERGENCY                1   //Associated objects: 1014, 1015
   #define CO_NO_TIME                     0   //Associated objects: 1012, 1013
   #define CO_NO_SDO_SERVER               1   //Associated objects: 1200-127F
-  #define CO_NO_SDO_CLIENT               1   //Associated objects: 1280-12FF
+  #define CO_NO_SDO_CLIENT               4   //Associated objects: 1280-12FF
   #define CO_NO_LSS_SERVER               0   //LSS Slave
-  #define CO_NO_LSS_CLIENT               0   //LSS Master
+  #define CO_NO_LSS_CLIENT               1   //LSS Master
   #define CO_NO_RPDO                     16   //Associated objects: 14xx, 16xx
   #define CO_NO_TPDO                     16   //Associated objects: 18xx, 1Axx
   #define CO_NO_NMT_MASTER               1
@@ -89,7 +89,7 @@
 /*******************************************************************************
    OBJECT DICTIONARY
 *******************************************************************************/
-   #define CO_OD_NoOfElements             100
+   #define CO_OD_NoOfElements             114
 
 
 /*******************************************************************************
@@ -149,6 +149,14 @@
                UNSIGNED32     mappedObject7;
                UNSIGNED32     mappedObject8;
                }              OD_TPDOMappingParameter_t;
+/*2120      */ typedef struct {
+               UNSIGNED8      maxSubIndex;
+               UNSIGNED32     NACKCount;
+               UNSIGNED32     arbitrationLostCount;
+               UNSIGNED32     busErrorCount;
+               UNSIGNED32     timeoutCount;
+               UNSIGNED32     recoveryCount;
+               }              OD_I2CBus_t;
 
 /*******************************************************************************
    TYPE DEFINITIONS FOR OBJECT DICTIONARY INDEXES
@@ -264,6 +272,30 @@
         #define OD_1280_2_SDOClientParameter_COB_IDServerToClient   2
         #define OD_1280_3_SDOClientParameter_nodeIDOfTheSDOServer   3
 
+/*1281 */
+        #define OD_1281_SDOClientParameter                          0x1281
+
+        #define OD_1281_0_SDOClientParameter_maxSubIndex            0
+        #define OD_1281_1_SDOClientParameter_COB_IDClientToServer   1
+        #define OD_1281_2_SDOClientParameter_COB_IDServerToClient   2
+        #define OD_1281_3_SDOClientParameter_nodeIDOfTheSDOServer   3
+
+/*1282 */
+        #define OD_1282_SDOClientParameter                          0x1282
+
+        #define OD_1282_0_SDOClientParameter_maxSubIndex            0
+        #define OD_1282_1_SDOClientParameter_COB_IDClientToServer   1
+        #define OD_1282_2_SDOClientParameter_COB_IDServerToClient   2
+        #define OD_1282_3_SDOClientParameter_nodeIDOfTheSDOServer   3
+
+/*1283 */
+        #define OD_1283_SDOClientParameter                          0x1283
+
+        #define OD_1283_0_SDOClientParameter_maxSubIndex            0
+        #define OD_1283_1_SDOClientParameter_COB_IDClientToServer   1
+        #define OD_1283_2_SDOClientParameter_COB_IDServerToClient   2
+        #define OD_1283_3_SDOClientParameter_nodeIDOfTheSDOServer   3
+
 /*1400 */
         #define OD_1400_RPDOCommunicationParameter                  0x1400
 
@@ -1287,6 +1319,215 @@
         #define OD_2109_0_voltage_maxSubIndex                       0
         #define OD_2109_1_voltage_MCU_VDDA                          1
 
+/*2110 */
+        #define OD_2110_OPDFaultCount                               0x2110
+
+        #define OD_2110_0_OPDFaultCount_maxSubIndex                 0
+        #define OD_2110_1_OPDFaultCount_Card_0x08                   1
+        #define OD_2110_2_OPDFaultCount_Card_0x09                   2
+        #define OD_2110_3_OPDFaultCount_Card_0x0A                   3
+        #define OD_2110_4_OPDFaultCount_Card_0x0B                   4
+        #define OD_2110_5_OPDFaultCount_Card_0x0C                   5
+        #define OD_2110_6_OPDFaultCount_Card_0x0D                   6
+        #define OD_2110_7_OPDFaultCount_Card_0x0E                   7
+        #define OD_2110_8_OPDFaultCount_Card_0x0F                   8
+        #define OD_2110_9_OPDFaultCount_Card_0x10                   9
+        #define OD_2110_10_OPDFaultCount_Card_0x11                  10
+        #define OD_2110_11_OPDFaultCount_Card_0x12                  11
+        #define OD_2110_12_OPDFaultCount_Card_0x13                  12
+        #define OD_2110_13_OPDFaultCount_Card_0x14                  13
+        #define OD_2110_14_OPDFaultCount_Card_0x15                  14
+        #define OD_2110_15_OPDFaultCount_Card_0x16                  15
+        #define OD_2110_16_OPDFaultCount_Card_0x17                  16
+        #define OD_2110_17_OPDFaultCount_Card_0x18                  17
+        #define OD_2110_18_OPDFaultCount_Card_0x19                  18
+        #define OD_2110_19_OPDFaultCount_Card_0x1A                  19
+        #define OD_2110_20_OPDFaultCount_Card_0x1B                  20
+        #define OD_2110_21_OPDFaultCount_Card_0x1C                  21
+        #define OD_2110_22_OPDFaultCount_Card_0x1D                  22
+        #define OD_2110_23_OPDFaultCount_Card_0x1E                  23
+        #define OD_2110_24_OPDFaultCount_Card_0x1F                  24
+        #define OD_2110_25_OPDFaultCount_Card_0x20                  25
+        #define OD_2110_26_OPDFaultCount_Card_0x21                  26
+        #define OD_2110_27_OPDFaultCount_Card_0x22                  27
+        #define OD_2110_28_OPDFaultCount_Card_0x23                  28
+        #define OD_2110_29_OPDFaultCount_Card_0x24                  29
+        #define OD_2110_30_OPDFaultCount_Card_0x25                  30
+        #define OD_2110_31_OPDFaultCount_Card_0x26                  31
+        #define OD_2110_32_OPDFaultCount_Card_0x27                  32
+        #define OD_2110_33_OPDFaultCount_Card_0x28                  33
+        #define OD_2110_34_OPDFaultCount_Card_0x29                  34
+        #define OD_2110_35_OPDFaultCount_Card_0x2A                  35
+        #define OD_2110_36_OPDFaultCount_Card_0x2B                  36
+        #define OD_2110_37_OPDFaultCount_Card_0x2C                  37
+        #define OD_2110_38_OPDFaultCount_Card_0x2D                  38
+        #define OD_2110_39_OPDFaultCount_Card_0x2E                  39
+        #define OD_2110_40_OPDFaultCount_Card_0x2F                  40
+        #define OD_2110_41_OPDFaultCount_Card_0x30                  41
+        #define OD_2110_42_OPDFaultCount_Card_0x31                  42
+        #define OD_2110_43_OPDFaultCount_Card_0x32                  43
+        #define OD_2110_44_OPDFaultCount_Card_0x33                  44
+        #define OD_2110_45_OPDFaultCount_Card_0x34                  45
+        #define OD_2110_46_OPDFaultCount_Card_0x35                  46
+        #define OD_2110_47_OPDFaultCount_Card_0x36                  47
+        #define OD_2110_48_OPDFaultCount_Card_0x37                  48
+        #define OD_2110_49_OPDFaultCount_Card_0x38                  49
+        #define OD_2110_50_OPDFaultCount_Card_0x39                  50
+        #define OD_2110_51_OPDFaultCount_Card_0x3A                  51
+        #define OD_2110_52_OPDFaultCount_Card_0x3B                  52
+        #define OD_2110_53_OPDFaultCount_Card_0x3C                  53
+        #define OD_2110_54_OPDFaultCount_Card_0x3D                  54
+        #define OD_2110_55_OPDFaultCount_Card_0x3E                  55
+        #define OD_2110_56_OPDFaultCount_Card_0x3F                  56
+
+/*2111 */
+        #define OD_2111_OPDTripTime                                 0x2111
+
+        #define OD_2111_0_OPDTripTime_maxSubIndex                   0
+        #define OD_2111_1_OPDTripTime_Card_0x08                     1
+        #define OD_2111_2_OPDTripTime_Card_0x09                     2
+        #define OD_2111_3_OPDTripTime_Card_0x0A                     3
+        #define OD_2111_4_OPDTripTime_Card_0x0B                     4
+        #define OD_2111_5_OPDTripTime_Card_0x0C                     5
+        #define OD_2111_6_OPDTripTime_Card_0x0D                     6
+        #define OD_2111_7_OPDTripTime_Card_0x0E                     7
+        #define OD_2111_8_OPDTripTime_Card_0x0F                     8
+        #define OD_2111_9_OPDTripTime_Card_0x10                     9
+        #define OD_2111_10_OPDTripTime_Card_0x11                    10
+        #define OD_2111_11_OPDTripTime_Card_0x12                    11
+        #define OD_2111_12_OPDTripTime_Card_0x13                    12
+        #define OD_2111_13_OPDTripTime_Card_0x14                    13
+        #define OD_2111_14_OPDTripTime_Card_0x15                    14
+        #define OD_2111_15_OPDTripTime_Card_0x16                    15
+        #define OD_2111_16_OPDTripTime_Card_0x17                    16
+        #define OD_2111_17_OPDTripTime_Card_0x18                    17
+        #define OD_2111_18_OPDTripTime_Card_0x19                    18
+        #define OD_2111_19_OPDTripTime_Card_0x1A                    19
+        #define OD_2111_20_OPDTripTime_Card_0x1B                    20
+        #define OD_2111_21_OPDTripTime_Card_0x1C                    21
+        #define OD_2111_22_OPDTripTime_Card_0x1D                    22
+        #define OD_2111_23_OPDTripTime_Card_0x1E                    23
+        #define OD_2111_24_OPDTripTime_Card_0x1F                    24
+        #define OD_2111_25_OPDTripTime_Card_0x20                    25
+        #define OD_2111_26_OPDTripTime_Card_0x21                    26
+        #define OD_2111_27_OPDTripTime_Card_0x22                    27
+        #define OD_2111_28_OPDTripTime_Card_0x23                    28
+        #define OD_2111_29_OPDTripTime_Card_0x24                    29
+        #define OD_2111_30_OPDTripTime_Card_0x25                    30
+        #define OD_2111_31_OPDTripTime_Card_0x26                    31
+        #define OD_2111_32_OPDTripTime_Card_0x27                    32
+        #define OD_2111_33_OPDTripTime_Card_0x28                    33
+        #define OD_2111_34_OPDTripTime_Card_0x29                    34
+        #define OD_2111_35_OPDTripTime_Card_0x2A                    35
+        #define OD_2111_36_OPDTripTime_Card_0x2B                    36
+        #define OD_2111_37_OPDTripTime_Card_0x2C                    37
+        #define OD_2111_38_OPDTripTime_Card_0x2D                    38
+        #define OD_2111_39_OPDTripTime_Card_0x2E                    39
+        #define OD_2111_40_OPDTripTime_Card_0x2F                    40
+        #define OD_2111_41_OPDTripTime_Card_0x30                    41
+        #define OD_2111_42_OPDTripTime_Card_0x31                    42
+        #define OD_2111_43_OPDTripTime_Card_0x32                    43
+        #define OD_2111_44_OPDTripTime_Card_0x33                    44
+        #define OD_2111_45_OPDTripTime_Card_0x34                    45
+        #define OD_2111_46_OPDTripTime_Card_0x35                    46
+        #define OD_2111_47_OPDTripTime_Card_0x36                    47
+        #define OD_2111_48_OPDTripTime_Card_0x37                    48
+        #define OD_2111_49_OPDTripTime_Card_0x38                    49
+        #define OD_2111_50_OPDTripTime_Card_0x39                    50
+        #define OD_2111_51_OPDTripTime_Card_0x3A                    51
+        #define OD_2111_52_OPDTripTime_Card_0x3B                    52
+        #define OD_2111_53_OPDTripTime_Card_0x3C                    53
+        #define OD_2111_54_OPDTripTime_Card_0x3D                    54
+        #define OD_2111_55_OPDTripTime_Card_0x3E                    55
+        #define OD_2111_56_OPDTripTime_Card_0x3F                    56
+
+/*2120 */
+        #define OD_2120_I2CBus                                      0x2120
+
+        #define OD_2120_0_I2CBus_maxSubIndex                        0
+        #define OD_2120_1_I2CBus_NACKCount                          1
+        #define OD_2120_2_I2CBus_arbitrationLostCount               2
+        #define OD_2120_3_I2CBus_busErrorCount                      3
+        #define OD_2120_4_I2CBus_timeoutCount                       4
+        #define OD_2120_5_I2CBus_recoveryCount                      5
+
+/*2121 */
+        #define OD_2121_I2CDeviceAddress                            0x2121
+
+        #define OD_2121_0_I2CDeviceAddress_maxSubIndex              0
+        #define OD_2121_1_I2CDeviceAddress_device1                  1
+        #define OD_2121_2_I2CDeviceAddress_device2                  2
+        #define OD_2121_3_I2CDeviceAddress_device3                  3
+        #define OD_2121_4_I2CDeviceAddress_device4                  4
+        #define OD_2121_5_I2CDeviceAddress_device5                  5
+        #define OD_2121_6_I2CDeviceAddress_device6                  6
+        #define OD_2121_7_I2CDeviceAddress_device7                  7
+        #define OD_2121_8_I2CDeviceAddress_device8                  8
+
+/*2122 */
+        #define OD_2122_I2CDeviceNACK                               0x2122
+
+        #define OD_2122_0_I2CDeviceNACK_maxSubIndex                 0
+        #define OD_2122_1_I2CDeviceNACK_device1                     1
+        #define OD_2122_2_I2CDeviceNACK_device2                     2
+        #define OD_2122_3_I2CDeviceNACK_device3                     3
+        #define OD_2122_4_I2CDeviceNACK_device4                     4
+        #define OD_2122_5_I2CDeviceNACK_device5                     5
+        #define OD_2122_6_I2CDeviceNACK_device6                     6
+        #define OD_2122_7_I2CDeviceNACK_device7                     7
+        #define OD_2122_8_I2CDeviceNACK_device8                     8
+
+/*2123 */
+        #define OD_2123_I2CDeviceTimeout                            0x2123
+
+        #define OD_2123_0_I2CDeviceTimeout_maxSubIndex              0
+        #define OD_2123_1_I2CDeviceTimeout_device1                  1
+        #define OD_2123_2_I2CDeviceTimeout_device2                  2
+        #define OD_2123_3_I2CDeviceTimeout_device3                  3
+        #define OD_2123_4_I2CDeviceTimeout_device4                  4
+        #define OD_2123_5_I2CDeviceTimeout_device5                  5
+        #define OD_2123_6_I2CDeviceTimeout_device6                  6
+        #define OD_2123_7_I2CDeviceTimeout_device7                  7
+        #define OD_2123_8_I2CDeviceTimeout_device8                  8
+
+/*2130 */
+        #define OD_2130_nodeAlive                                   0x2130
+
+        #define OD_2130_0_nodeAlive_maxSubIndex                     0
+        #define OD_2130_1_nodeAlive_nodes0_31                       1
+        #define OD_2130_2_nodeAlive_nodes32_63                      2
+        #define OD_2130_3_nodeAlive_nodes64_95                      3
+        #define OD_2130_4_nodeAlive_nodes96_127                     4
+
+/*2131 */
+        #define OD_2131_nodeOperational                             0x2131
+
+        #define OD_2131_0_nodeOperational_maxSubIndex               0
+        #define OD_2131_1_nodeOperational_nodes0_31                 1
+        #define OD_2131_2_nodeOperational_nodes32_63                2
+        #define OD_2131_3_nodeOperational_nodes64_95                3
+        #define OD_2131_4_nodeOperational_nodes96_127               4
+
+/*2132 */
+        #define OD_2132_heartbeatTimeout                            0x2132
+
+/*2133 */
+        #define OD_2133_LSSScan                                     0x2133
+
+        #define OD_2133_0_LSSScan_maxSubIndex                       0
+        #define OD_2133_1_LSSScan_nodesAssigned                     1
+        #define OD_2133_2_LSSScan_scanTime                          2
+
+/*2140 */
+        #define OD_2140_CANLog                                      0x2140
+
+        #define OD_2140_0_CANLog_maxSubIndex                        0
+        #define OD_2140_1_CANLog_frames                             1
+        #define OD_2140_2_CANLog_dropped                            2
+        #define OD_2140_3_CANLog_ringHighWatermark                  3
+        #define OD_2140_4_CANLog_blocksWritten                      4
+        #define OD_2140_5_CANLog_writeErrors                        5
+
 /*******************************************************************************
    STRUCTURES FOR VARIABLES IN DIFFERENT MEMORY LOCATIONS
 *******************************************************************************/
@@ -1332,7 +1573,7 @@ struct sCO_OD_RAM{
 /*1003      */ UNSIGNED32      preDefinedErrorField[8];
 /*1010      */ UNSIGNED32      storeParameters[1];
 /*1011      */ UNSIGNED32      restoreDefaultParameters[1];
-/*1280      */ OD_SDOClientParameter_t SDOClientParameter[1];
+/*1280      */ OD_SDOClientParameter_t SDOClientParameter[4];
 /*1F81      */ UNSIGNED32      slaveAssignment[127];
 /*1F82      */ UNSIGNED8       requestNMT[127];
 /*1F89      */ UNSIGNED32     bootTime;
@@ -1344,6 +1585,17 @@ struct sCO_OD_RAM{
 /*2107      */ UNSIGNED16      sensors[3];
 /*2108      */ INTEGER16       temperature[1];
 /*2109      */ INTEGER16       voltage[1];
+/*2110      */ UNSIGNED16      OPDFaultCount[56];
+/*2111      */ UNSIGNED32      OPDTripTime[56];
+/*2120      */ OD_I2CBus_t I2CBus;
+/*2121      */ UNSIGNED8       I2CDeviceAddress[8];
+/*2122      */ UNSIGNED16      I2CDeviceNACK[8];
+/*2123      */ UNSIGNED16      I2CDeviceTimeout[8];
+/*2130      */ UNSIGNED32      nodeAlive[4];
+/*2131      */ UNSIGNED32      nodeOperational[4];
+/*2132      */ UNSIGNED16     heartbeatTimeout;
+/*2133      */ UNSIGNED32      LSSScan[2];
+/*2140      */ UNSIGNED32      CANLog[5];
 
                UNSIGNED32     LastWord;
 };
@@ -1521,5 +1773,198 @@ extern struct sCO_OD_EEPROM CO_OD_EEPROM;
         #define ODL_voltage_arrayLength                             1
         #define ODA_voltage_MCU_VDDA                                0
 
+/*2110, Data Type: UNSIGNED16, Array[56] */
+        #define OD_OPDFaultCount                                    CO_OD_RAM.OPDFaultCount
+        #define ODL_OPDFaultCount_arrayLength                       56
+        #define ODA_OPDFaultCount_Card_0x08                         0
+        #define ODA_OPDFaultCount_Card_0x09                         1
+        #define ODA_OPDFaultCount_Card_0x0A                         2
+        #define ODA_OPDFaultCount_Card_0x0B                         3
+        #define ODA_OPDFaultCount_Card_0x0C                         4
+        #define ODA_OPDFaultCount_Card_0x0D                         5
+        #define ODA_OPDFaultCount_Card_0x0E                         6
+        #define ODA_OPDFaultCount_Card_0x0F                         7
+        #define ODA_OPDFaultCount_Card_0x10                         8
+        #define ODA_OPDFaultCount_Card_0x11                         9
+        #define ODA_OPDFaultCount_Card_0x12                         10
+        #define ODA_OPDFaultCount_Card_0x13                         11
+        #define ODA_OPDFaultCount_Card_0x14                         12
+        #define ODA_OPDFaultCount_Card_0x15                         13
+        #define ODA_OPDFaultCount_Card_0x16                         14
+        #define ODA_OPDFaultCount_Card_0x17                         15
+        #define ODA_OPDFaultCount_Card_0x18                         16
+        #define ODA_OPDFaultCount_Card_0x19                         17
+        #define ODA_OPDFaultCount_Card_0x1A                         18
+        #define ODA_OPDFaultCount_Card_0x1B                         19
+        #define ODA_OPDFaultCount_Card_0x1C                         20
+        #define ODA_OPDFaultCount_Card_0x1D                         21
+        #define ODA_OPDFaultCount_Card_0x1E                         22
+        #define ODA_OPDFaultCount_Card_0x1F                         23
+        #define ODA_OPDFaultCount_Card_0x20                         24
+        #define ODA_OPDFaultCount_Card_0x21                         25
+        #define ODA_OPDFaultCount_Card_0x22                         26
+        #define ODA_OPDFaultCount_Card_0x23                         27
+        #define ODA_OPDFaultCount_Card_0x24                         28
+        #define ODA_OPDFaultCount_Card_0x25                         29
+        #define ODA_OPDFaultCount_Card_0x26                         30
+        #define ODA_OPDFaultCount_Card_0x27                         31
+        #define ODA_OPDFaultCount_Card_0x28                         32
+        #define ODA_OPDFaultCount_Card_0x29                         33
+        #define ODA_OPDFaultCount_Card_0x2A                         34
+        #define ODA_OPDFaultCount_Card_0x2B                         35
+        #define ODA_OPDFaultCount_Card_0x2C                         36
+        #define ODA_OPDFaultCount_Card_0x2D                         37
+        #define ODA_OPDFaultCount_Card_0x2E                         38
+        #define ODA_OPDFaultCount_Card_0x2F                         39
+        #define ODA_OPDFaultCount_Card_0x30                         40
+        #define ODA_OPDFaultCount_Card_0x31                         41
+        #define ODA_OPDFaultCount_Card_0x32                         42
+        #define ODA_OPDFaultCount_Card_0x33                         43
+        #define ODA_OPDFaultCount_Card_0x34                         44
+        #define ODA_OPDFaultCount_Card_0x35                         45
+        #define ODA_OPDFaultCount_Card_0x36                         46
+        #define ODA_OPDFaultCount_Card_0x37                         47
+        #define ODA_OPDFaultCount_Card_0x38                         48
+        #define ODA_OPDFaultCount_Card_0x39                         49
+        #define ODA_OPDFaultCount_Card_0x3A                         50
+        #define ODA_OPDFaultCount_Card_0x3B                         51
+        #define ODA_OPDFaultCount_Card_0x3C                         52
+        #define ODA_OPDFaultCount_Card_0x3D                         53
+        #define ODA_OPDFaultCount_Card_0x3E                         54
+        #define ODA_OPDFaultCount_Card_0x3F                         55
+
+/*2111, Data Type: UNSIGNED32, Array[56] */
+        #define OD_OPDTripTime                                      CO_OD_RAM.OPDTripTime
+        #define ODL_OPDTripTime_arrayLength                         56
+        #define ODA_OPDTripTime_Card_0x08                           0
+        #define ODA_OPDTripTime_Card_0x09                           1
+        #define ODA_OPDTripTime_Card_0x0A                           2
+        #define ODA_OPDTripTime_Card_0x0B                           3
+        #define ODA_OPDTripTime_Card_0x0C                           4
+        #define ODA_OPDTripTime_Card_0x0D                           5
+        #define ODA_OPDTripTime_Card_0x0E                           6
+        #define ODA_OPDTripTime_Card_0x0F                           7
+        #define ODA_OPDTripTime_Card_0x10                           8
+        #define ODA_OPDTripTime_Card_0x11                           9
+        #define ODA_OPDTripTime_Card_0x12                           10
+        #define ODA_OPDTripTime_Card_0x13                           11
+        #define ODA_OPDTripTime_Card_0x14                           12
+        #define ODA_OPDTripTime_Card_0x15                           13
+        #define ODA_OPDTripTime_Card_0x16                           14
+        #define ODA_OPDTripTime_Card_0x17                           15
+        #define ODA_OPDTripTime_Card_0x18                           16
+        #define ODA_OPDTripTime_Card_0x19                           17
+        #define ODA_OPDTripTime_Card_0x1A                           18
+        #define ODA_OPDTripTime_Card_0x1B                           19
+        #define ODA_OPDTripTime_Card_0x1C                           20
+        #define ODA_OPDTripTime_Card_0x1D                           21
+        #define ODA_OPDTripTime_Card_0x1E                           22
+        #define ODA_OPDTripTime_Card_0x1F                           23
+        #define ODA_OPDTripTime_Card_0x20                           24
+        #define ODA_OPDTripTime_Card_0x21                           25
+        #define ODA_OPDTripTime_Card_0x22                           26
+        #define ODA_OPDTripTime_Card_0x23                           27
+        #define ODA_OPDTripTime_Card_0x24                           28
+        #define ODA_OPDTripTime_Card_0x25                           29
+        #define ODA_OPDTripTime_Card_0x26                           30
+        #define ODA_OPDTripTime_Card_0x27                           31
+        #define ODA_OPDTripTime_Card_0x28                           32
+        #define ODA_OPDTripTime_Card_0x29                           33
+        #define ODA_OPDTripTime_Card_0x2A                           34
+        #define ODA_OPDTripTime_Card_0x2B                           35
+        #define ODA_OPDTripTime_Card_0x2C                           36
+        #define ODA_OPDTripTime_Card_0x2D                           37
+        #define ODA_OPDTripTime_Card_0x2E                           38
+        #define ODA_OPDTripTime_Card_0x2F                           39
+        #define ODA_OPDTripTime_Card_0x30                           40
+        #define ODA_OPDTripTime_Card_0x31                           41
+        #define ODA_OPDTripTime_Card_0x32                           42
+        #define ODA_OPDTripTime_Card_0x33                           43
+        #define ODA_OPDTripTime_Card_0x34                           44
+        #define ODA_OPDTripTime_Card_0x35                           45
+        #define ODA_OPDTripTime_Card_0x36                           46
+        #define ODA_OPDTripTime_Card_0x37                           47
+        #define ODA_OPDTripTime_Card_0x38                           48
+        #define ODA_OPDTripTime_Card_0x39                           49
+        #define ODA_OPDTripTime_Card_0x3A                           50
+        #define ODA_OPDTripTime_Card_0x3B                           51
+        #define ODA_OPDTripTime_Card_0x3C                           52
+        #define ODA_OPDTripTime_Card_0x3D                           53
+        #define ODA_OPDTripTime_Card_0x3E                           54
+        #define ODA_OPDTripTime_Card_0x3F                           55
+
+/*2120, Data Type: I2CBus_t */
+        #define OD_I2CBus                                           CO_OD_RAM.I2CBus
+
+/*2121, Data Type: UNSIGNED8, Array[8] */
+        #define OD_I2CDeviceAddress                                 CO_OD_RAM.I2CDeviceAddress
+        #define ODL_I2CDeviceAddress_arrayLength                    8
+        #define ODA_I2CDeviceAddress_device1                        0
+        #define ODA_I2CDeviceAddress_device2                        1
+        #define ODA_I2CDeviceAddress_device3                        2
+        #define ODA_I2CDeviceAddress_device4                        3
+        #define ODA_I2CDeviceAddress_device5                        4
+        #define ODA_I2CDeviceAddress_device6                        5
+        #define ODA_I2CDeviceAddress_device7                        6
+        #define ODA_I2CDeviceAddress_device8                        7
+
+/*2122, Data Type: UNSIGNED16, Array[8] */
+        #define OD_I2CDeviceNACK                                    CO_OD_RAM.I2CDeviceNACK
+        #define ODL_I2CDeviceNACK_arrayLength                       8
+        #define ODA_I2CDeviceNACK_device1                           0
+        #define ODA_I2CDeviceNACK_device2                           1
+        #define ODA_I2CDeviceNACK_device3                           2
+        #define ODA_I2CDeviceNACK_device4                           3
+        #define ODA_I2CDeviceNACK_device5                           4
+        #define ODA_I2CDeviceNACK_device6                           5
+        #define ODA_I2CDeviceNACK_device7                           6
+        #define ODA_I2CDeviceNACK_device8                           7
+
+/*2123, Data Type: UNSIGNED16, Array[8] */
+        #define OD_I2CDeviceTimeout                                 CO_OD_RAM.I2CDeviceTimeout
+        #define ODL_I2CDeviceTimeout_arrayLength                    8
+        #define ODA_I2CDeviceTimeout_device1                        0
+        #define ODA_I2CDeviceTimeout_device2                        1
+        #define ODA_I2CDeviceTimeout_device3                        2
+        #define ODA_I2CDeviceTimeout_device4                        3
+        #define ODA_I2CDeviceTimeout_device5                        4
+        #define ODA_I2CDeviceTimeout_device6                        5
+        #define ODA_I2CDeviceTimeout_device7                        6
+        #define ODA_I2CDeviceTimeout_device8                        7
+
+/*2130, Data Type: UNSIGNED32, Array[4] */
+        #define OD_nodeAlive                                        CO_OD_RAM.nodeAlive
+        #define ODL_nodeAlive_arrayLength                           4
+        #define ODA_nodeAlive_nodes0_31                             0
+        #define ODA_nodeAlive_nodes32_63                            1
+        #define ODA_nodeAlive_nodes64_95                            2
+        #define ODA_nodeAlive_nodes96_127                           3
+
+/*2131, Data Type: UNSIGNED32, Array[4] */
+        #define OD_nodeOperational                                  CO_OD_RAM.nodeOperational
+        #define ODL_nodeOperational_arrayLength                     4
+        #define ODA_nodeOperational_nodes0_31                       0
+        #define ODA_nodeOperational_nodes32_63                      1
+        #define ODA_nodeOperational_nodes64_95                      2
+        #define ODA_nodeOperational_nodes96_127                     3
+
+/*2132, Data Type: UNSIGNED16 */
+        #define OD_heartbeatTimeout                                 CO_OD_RAM.heartbeatTimeout
+
+/*2133, Data Type: UNSIGNED32, Array[2] */
+        #define OD_LSSScan                                          CO_OD_RAM.LSSScan
+        #define ODL_LSSScan_arrayLength                             2
+        #define ODA_LSSScan_nodesAssigned                           0
+        #define ODA_LSSScan_scanTime                                1
+
+/*2140, Data Type: UNSIGNED32, Array[5] */
+        #define OD_CANLog                                           CO_OD_RAM.CANLog
+        #define ODL_CANLog_arrayLength                              5
+        #define ODA_CANLog_frames                                   0
+        #define ODA_CANLog_dropped                                  1
+        #define ODA_CANLog_ringHighWatermark                        2
+        #define ODA_CANLog_blocksWritten                            3
+        #define ODA_CANLog_writeErrors                              4
+
 #endif
 // clang-format on
@@ -0,0 +1,183 @@
+#include <string.h>
+
+#include "can_log.h"
+#include "log_store.h"
+#include "CANopen.h"
+
+#define LOG_POLL                TIME_MS2I(50)
+#define LOG_RETRY               TIME_MS2I(1000)
+
+/* Block buffers, in DMA capable RAM */
+static can_log_block_t ring[CAN_LOG_BLOCKS];
+/*
+ * Completed and written block counts. The CAN RX interrupt fills the block
+ * at head and is the only writer of head, the thread writes the blocks
+ * from tail to head and is the only writer of tail.
+ */
+static volatile uint32_t head;
+static volatile uint32_t tail;
+/* Records in the block being filled, 0 if it is not started */
+static unsigned int fill;
+static volatile bool active;
+
+/* Statistics, written by the CAN RX interrupt */
+static volatile uint32_t frames;
+static volatile uint32_t dropped;
+static volatile uint32_t high_watermark;
+static uint32_t dropped_blk;
+/* Statistics of the writer */
+static uint32_t written;
+static uint32_t errors;
+
+static void can_log_close(void)
+{
+    ring[head % CAN_LOG_BLOCKS].hdr.count = fill - 1;
+    fill = 0;
+    __DMB();
+    head++;
+    if (head - tail > high_watermark)
+        high_watermark = head - tail;
+}
+
+/* Frame from the CAN RX interrupt */
+static void can_log_rx(void *object, const CO_CANrxMsg_t *msg)
+{
+    can_log_block_t *blk;
+    can_log_rec_t *rec;
+    uint32_t rtcnt = chSysGetRealtimeCounterX();
+
+    (void)object;
+
+    if (!active)
+        return;
+    if (head - tail >= CAN_LOG_BLOCKS) {
+        dropped++;
+        dropped_blk++;
+        return;
+    }
+
+    blk = &ring[head % CAN_LOG_BLOCKS];
+    if (fill == 0) {
+        blk->hdr.magic = CAN_LOG_MAGIC;
+        blk->hdr.dropped = dropped_blk > 0xFF ? 0xFF : dropped_blk;
+        blk->hdr.seq = head;
+        blk->hdr.systime = chVTGetSystemTimeX();
+        blk->hdr.rtcnt = rtcnt;
+        dropped_blk = 0;
+        fill = 1;
+    }
+    rec = &blk->rec[fill];
+    rec->id = (msg->IDE ? msg->EID : msg->SID) | (msg->RTR ? CAN_LOG_RTR : 0) | (msg->IDE ? CAN_LOG_IDE : 0);
+    rec->time = (rtcnt & CAN_LOG_TIME_MASK) | ((uint32_t)msg->DLC << CAN_LOG_DLC_Pos);
+    memcpy(rec->data, msg->data, 8);
+    frames++;
+
+    if (++fill == CAN_LOG_RECS_PER_BLOCK)
+        can_log_close();
+}
+
+void can_log_init(void)
+{
+    CO_CANrxMonitorInit(CAN_LOG_RX_MONITOR, NULL, can_log_rx);
+}
+
+/* The card is in use by the logger */
+bool can_log_active(void)
+{
+    return active;
+}
+
+/* Close the block being filled if it holds frames older than the flush period */
+static void can_log_age(void)
+{
+    chSysLock();
+    if (fill > 0 && chTimeDiffX(ring[head % CAN_LOG_BLOCKS].hdr.systime, chVTGetSystemTimeX()) >= CAN_LOG_FLUSH_PERIOD)
+        can_log_close();
+    chSysUnlock();
+}
+
+static void can_log_stats(void)
+{
+    CO_LOCK_OD();
+    OD_CANLog[ODA_CANLog_frames] = frames;
+    OD_CANLog[ODA_CANLog_dropped] = dropped;
+    OD_CANLog[ODA_CANLog_ringHighWatermark] = high_watermark;
+    OD_CANLog[ODA_CANLog_blocksWritten] = written;
+    OD_CANLog[ODA_CANLog_writeErrors] = errors;
+    CO_UNLOCK_OD();
+}
+
+/*
+ * Append pending blocks to the store, as many as are contiguous in the
+ * ring. Returns the number of blocks written, 0 on a failed write.
+ */
+static uint32_t can_log_write(void)
+{
+    uint32_t idx = tail % CAN_LOG_BLOCKS;
+    uint32_t n = head - tail;
+
+    if (n > CAN_LOG_BLOCKS - idx)
+        n = CAN_LOG_BLOCKS - idx;
+    n = log_store_append(&ring[idx], n);
+    if (n == 0) {
+        errors++;
+        return 0;
+    }
+    written += n;
+    __DMB();
+    tail += n;
+    return n;
+}
+
+THD_WORKING_AREA(can_log_wa, 0x200);
+THD_FUNCTION(can_log, arg)
+{
+    systime_t last_write;
+
+    (void)arg;
+
+    /* The card may be missing, or held by a shell command */
+    while (!chThdShouldTerminateX() && (!blkIsInserted(&SDCD1) || sdcConnect(&SDCD1) || !log_store_open()))
+        chThdSleep(LOG_RETRY);
+    if (chThdShouldTerminateX())
+        chThdExit(MSG_OK);
+
+    chSysLock();
+    tail = head;
+    fill = 0;
+    active = true;
+    chSysUnlock();
+    last_write = chVTGetSystemTime();
+
+    while (!chThdShouldTerminateX()) {
+        /* Partial bursts are written once nothing was written for a flush period */
+        bool due = chTimeDiffX(last_write, chVTGetSystemTime()) >= CAN_LOG_FLUSH_PERIOD;
+
+        can_log_age();
+        log_store_sync();
+        if (head - tail >= CAN_LOG_BURST || (due && head != tail)) {
+            /* A failed write is retried, the ring absorbs the delay until it is full */
+            if (can_log_write() != 0)
+                last_write = chVTGetSystemTime();
+            else
+                chThdSleep(LOG_POLL);
+            continue;
+        }
+        can_log_stats();
+        chThdSleep(LOG_POLL);
+    }
+
+    /* Write out what is left */
+    chSysLock();
+    active = false;
+    if (fill > 0)
+        can_log_close();
+    chSysUnlock();
+    while (head != tail && can_log_write() != 0)
+        ;
+    log_store_close();
+    can_log_stats();
+    sdcDisconnect(&SDCD1);
+
+    chThdExit(MSG_OK);
+}
@@ -0,0 +1,91 @@
+#ifndef _CAN_LOG_H_
+#define _CAN_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/* Ring size in SD blocks, 64 blocks hold about 100 ms of a fully loaded 1 Mbit/s bus */
+#ifndef CAN_LOG_BLOCKS
+#define CAN_LOG_BLOCKS          64
+#endif
+
+/*
+ * Blocks collected before a write. The store splits writes at multiples of
+ * this within a segment, so full bursts land aligned on the card.
+ */
+#ifndef CAN_LOG_BURST
+#define CAN_LOG_BURST           16
+#endif
+
+/*
+ * Longest time frames wait in RAM before a partial block is written. It
+ * also bounds the time spanned by a block, which must stay under 2^28
+ * realtime counter ticks for the record timestamps to be unambiguous.
+ */
+#ifndef CAN_LOG_FLUSH_PERIOD
+#define CAN_LOG_FLUSH_PERIOD    TIME_MS2I(500)
+#endif
+
+/* CAN receive monitor slot */
+#ifndef CAN_LOG_RX_MONITOR
+#define CAN_LOG_RX_MONITOR      2
+#endif
+
+#define CAN_LOG_MAGIC           0xCA11
+
+/* Record flags and fields */
+#define CAN_LOG_ID_MASK         0x1FFFFFFFU
+#define CAN_LOG_RTR             (1U << 29)
+#define CAN_LOG_IDE             (1U << 30)
+#define CAN_LOG_TIME_MASK       0x0FFFFFFFU
+#define CAN_LOG_DLC_Pos         28
+
+#define CAN_LOG_RECS_PER_BLOCK  32
+
+/*
+ * Log block format. Each 512 byte block starts with a header followed by
+ * up to 31 frame records. A frame time is the low 28 bits of the realtime
+ * counter (core clock), completed with the counter value in the block
+ * header. Blocks are stored in segments by log_store.
+ */
+typedef struct {
+    uint16_t magic;
+    uint8_t count;              /* Frame records in the block */
+    uint8_t dropped;            /* Frames dropped since the previous block, saturated */
+    uint32_t seq;               /* Block number since the logger started */
+    uint32_t systime;           /* System time of the first frame */
+    uint32_t rtcnt;             /* Realtime counter of the first frame */
+} can_log_hdr_t;
+
+typedef struct {
+    uint32_t id;                /* Identifier, CAN_LOG_RTR and CAN_LOG_IDE */
+    uint32_t time;              /* Low realtime counter bits, DLC in the top 4 bits */
+    uint8_t data[8];
+} can_log_rec_t;
+
+typedef union {
+    can_log_hdr_t hdr;
+    can_log_rec_t rec[CAN_LOG_RECS_PER_BLOCK];
+} can_log_block_t;
+
+/*
+ * CAN traffic logger. Every received frame is appended to a RAM ring of
+ * SD blocks from the CAN receive interrupt, without locks, and a low
+ * priority thread appends the completed blocks to the log store in
+ * multi-block writes. Frames that find the ring full are dropped and counted. The
+ * statistics are in 0x2140.
+ */
+extern THD_WORKING_AREA(can_log_wa, 0x200);
+extern THD_FUNCTION(can_log, arg);
+
+void can_log_init(void);
+bool can_log_active(void);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
@@ -3,6 +3,9 @@
 
 #include "command.h"
 #include "CO_master.h"
+#include "od_cache.h"
+#include "lss_scan.h"
+#include "log_store.h"
 #include "opd.h"
 #include "max7310.h"
 #include "mmc.h"
@@ -13,6 +16,10 @@
 #define BUF_SIZE 0x10000 /* 64k */
 #endif
 
+#ifndef SDO_BATCH_MAX
+#define SDO_BATCH_MAX 16
+#endif
+
 static uint8_t data[BUF_SIZE];
 
 /*===========================================================================*/
@@ -54,18 +61,28 @@ void cmd_nmt(BaseSequentialStream *chp, int argc, char *argv[])
 /*===========================================================================*/
 void sdo_usage(BaseSequentialStream *chp)
 {
-    chprintf(chp, "Usage: sdo read|write <NodeID> <index> <subindex> [blockmode]\r\n");
+    chprintf(chp, "Usage: sdo read|write <NodeID> <index> <subindex>[-<last>] [blockmode]\r\n");
+    chprintf(chp, "       sdo learn <NodeID>\r\n");
 }
 
 void cmd_sdo(BaseSequentialStream *chp, int argc, char *argv[])
 {
-    uint32_t data_len = 0;
-    uint32_t abrt_code = 0;
+    static sdo_req_t reqs[SDO_BATCH_MAX];
     uint8_t node_id = 0;
     uint16_t index = 0;
-    uint8_t subindex = 0;
+    uint8_t subindex = 0, last = 0;
+    uint32_t n, size;
+    char *end;
     bool block = false;
 
+    if (argc == 2 && !strcmp(argv[0], "learn")) {
+        int mapped = od_cache_learn(strtoul(argv[1], NULL, 0));
+        if (mapped < 0)
+            chprintf(chp, "No answer from node\r\n");
+        else
+            chprintf(chp, "Mirroring %d objects from TPDOs\r\n", mapped);
+        return;
+    }
     if (argc < 4) {
         sdo_usage(chp);
         return;
@@ -73,30 +90,149 @@ void cmd_sdo(BaseSequentialStream *chp, int argc, char *argv[])
 
     node_id = strtoul(argv[1], NULL, 0);
     index = strtoul(argv[2], NULL, 0);
-    subindex = strtoul(argv[3], NULL, 0);
+    subindex = last = strtoul(argv[3], &end, 0);
+    if (*end == '-')
+        last = strtoul(end + 1, NULL, 0);
     if (argc == 5)
         block = !strcmp(argv[4], "true");
+    if (last < subindex || last - subindex >= SDO_BATCH_MAX) {
+        chprintf(chp, "At most %u subindexes per request\r\n", SDO_BATCH_MAX);
+        return;
+    }
 
     if (!strcmp(argv[0], "read")) {
-        sdo_upload(CO->SDOclient[0], node_id, index, subindex, data, sizeof(data) - 1, &data_len, &abrt_code, 1000, block);
-        data[data_len] = '\0';
-        if (abrt_code == CO_SDO_AB_NONE) {
-            chprintf(chp, "Received %u bytes of data:", data_len);
-            for (uint32_t i = 0; i < data_len; i++)
-                chprintf(chp, " %02X", data[i]);
-            chprintf(chp, "\r\n");
-        } else {
-            chprintf(chp, "Received abort code: %x\r\n", abrt_code);
+        /* Fresh TPDO values are served from the mirror, the rest go through the pool */
+        n = 0;
+        size = sizeof(data) / (last - subindex + 1);
+        for (uint32_t sub = subindex; sub <= last; sub++) {
+            uint8_t val[8];
+            uint32_t len;
+            sysinterval_t age;
+
+            if (!block && od_cache_get(node_id, index, sub, OD_CACHE_MAX_AGE, val, &len, &age)) {
+                chprintf(chp, "%04X:%02X Cached %u bytes of data, %u ms old:", index, sub, len, TIME_I2MS(age));
+                for (uint32_t j = 0; j < len; j++)
+                    chprintf(chp, " %02X", val[j]);
+                chprintf(chp, "\r\n");
+                continue;
+            }
+            reqs[n++] = (sdo_req_t){
+                .node_id = node_id,
+                .index = index,
+                .subindex = sub,
+                .data = &data[(sub - subindex) * size],
+                .len = size,
+                .upload = true,
+                .block = block,
+                .timeout = 1000,
+            };
+        }
+        if (n == 0)
+            return;
+        if (!sdo_submit_batch(reqs, n)) {
+            chprintf(chp, "SDO client pool not running\r\n");
+            return;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            sdo_req_t *req = &reqs[i];
+
+            sdo_result(req);
+            chprintf(chp, "%04X:%02X ", req->index, req->subindex);
+            if (req->status == CO_SDOcli_ok_communicationEnd) {
+                uint8_t *buf = req->data;
+                chprintf(chp, "Received %u bytes of data:", req->ret_len);
+                for (uint32_t j = 0; j < req->ret_len; j++)
+                    chprintf(chp, " %02X", buf[j]);
+                chprintf(chp, "\r\n");
+            } else {
+                chprintf(chp, "Failed (%d), abort code: %x\r\n", req->status, req->abrt_code);
+            }
         }
     } else if (!strcmp(argv[0], "write")) {
         chprintf(chp, "Disabled for now\r\n");
-        /*sdo_download(CO->SDOclient[0], node_id, index, subindex, data, data_len, &abrt_code, 1000, block);*/
+        /*sdo_download(node_id, index, subindex, data, data_len, &abrt_code, 1000, block);*/
     } else {
         sdo_usage(chp);
         return;
     }
 }
 
+/*===========================================================================*/
+/* CAN Layer Setting Services                                                */
+/*===========================================================================*/
+void lss_usage(BaseSequentialStream *chp)
+{
+    chprintf(chp, "Usage: lss scan\r\n");
+}
+
+void cmd_lss(BaseSequentialStream *chp, int argc, char *argv[])
+{
+    int count;
+
+    if (argc < 1 || strcmp(argv[0], "scan")) {
+        lss_usage(chp);
+        return;
+    }
+
+    count = lss_scan_run();
+    if (count < 0)
+        chprintf(chp, "Scan failed\r\n");
+    else
+        chprintf(chp, "Assigned %d nodes in %u ms\r\n", count, (unsigned int)OD_LSSScan[ODA_LSSScan_scanTime]);
+}
+
+/*===========================================================================*/
+/* CAN Log                                                                   */
+/*===========================================================================*/
+void log_usage(BaseSequentialStream *chp)
+{
+    chprintf(chp, "Usage: log status\r\n"
+                  "       log query <NodeID> <t1_ms> <t2_ms> [COB-ID]\r\n");
+}
+
+static bool log_print(const can_log_rec_t *rec, uint64_t t, void *arg)
+{
+    BaseSequentialStream *chp = arg;
+    unsigned int dlc = (rec->time >> CAN_LOG_DLC_Pos) & 0xF;
+
+    chprintf(chp, "%lu.%03u %s%X [%u]", (unsigned long)(t / 1000), (unsigned int)(t % 1000),
+            (rec->id & CAN_LOG_RTR) ? "R " : "", (unsigned int)(rec->id & CAN_LOG_ID_MASK), dlc);
+    for (unsigned int i = 0; i < dlc && i < 8 && !(rec->id & CAN_LOG_RTR); i++)
+        chprintf(chp, " %02X", rec->data[i]);
+    chprintf(chp, "\r\n");
+    return true;
+}
+
+void cmd_log(BaseSequentialStream *chp, int argc, char *argv[])
+{
+    log_store_info_t info;
+    log_query_t q;
+    int count;
+
+    if (argc == 1 && !strcmp(argv[0], "status")) {
+        if (!log_store_info(&info)) {
+            chprintf(chp, "Log store not open\r\n");
+            return;
+        }
+        chprintf(chp, "Segments: %lu-%lu of %lu, index stride %lu\r\n",
+                (unsigned long)info.oldest, (unsigned long)info.next,
+                (unsigned long)info.segments, (unsigned long)info.stride);
+        chprintf(chp, "Log time: %lu ms\r\n", (unsigned long)info.now);
+    } else if ((argc == 4 || argc == 5) && !strcmp(argv[0], "query")) {
+        q.node_id = strtoul(argv[1], NULL, 0);
+        q.t1 = strtoull(argv[2], NULL, 0);
+        q.t2 = strtoull(argv[3], NULL, 0);
+        q.cob_id = (argc == 5 ? strtoul(argv[4], NULL, 0) : LOG_STORE_ANY_COB);
+        count = log_store_query(&q, log_print, chp);
+        if (count < 0)
+            chprintf(chp, "Log store not open\r\n");
+        else
+            chprintf(chp, "%d frames\r\n", count);
+    } else {
+        log_usage(chp);
+    }
+}
+
 /*===========================================================================*/
 /* OreSat Power Domain Control                                               */
 /*===========================================================================*/
@@ -164,6 +300,8 @@ void cmd_opd(BaseSequentialStream *chp, int argc, char *argv[])
 static const ShellCommand commands[] = {
     {"nmt", cmd_nmt},
     {"sdo", cmd_sdo},
+    {"lss", cmd_lss},
+    {"log", cmd_log},
     {"opd", cmd_opd},
     {"sdc", cmd_sdc},
     {NULL, NULL}
@@ -0,0 +1,214 @@
+#include <string.h>
+
+#include "hb_monitor.h"
+#include "CANopen.h"
+
+#define HB_NODES                128
+#define HB_COB_ID               0x700
+#define HB_NO_POS               0xFF
+
+/* Deadlines are less than half the systime_t range apart */
+#define HB_BEFORE(a, b)         ((systime_t)((b) - (a) - 1U) < ((systime_t)-1) / 2U)
+
+typedef struct {
+    systime_t deadline;
+    uint8_t state;
+    uint8_t pos;                /* Heap position, HB_NO_POS if not monitored */
+} hb_node_t;
+
+event_source_t hb_event;
+
+/* Written by the CAN RX interrupt and under the kernel lock elsewhere */
+static hb_node_t nodes[HB_NODES];
+static uint8_t heap[HB_NODES];
+static uint8_t heap_len;
+static uint32_t alive[4];
+static uint32_t operational[4];
+static uint32_t changed[4];
+static eventflags_t flags;
+
+/* Signalled on state changes, and when the earliest deadline moves up */
+static BSEMAPHORE_DECL(hb_bsem, true);
+
+static void heap_set(uint8_t pos, uint8_t node_id)
+{
+    heap[pos] = node_id;
+    nodes[node_id].pos = pos;
+}
+
+static void heap_up(uint8_t pos)
+{
+    uint8_t node_id = heap[pos];
+
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!HB_BEFORE(nodes[node_id].deadline, nodes[heap[parent]].deadline))
+            break;
+        heap_set(pos, heap[parent]);
+        pos = parent;
+    }
+    heap_set(pos, node_id);
+}
+
+static void heap_down(uint8_t pos)
+{
+    uint8_t node_id = heap[pos];
+
+    for (;;) {
+        uint8_t child = 2 * pos + 1;
+        if (child >= heap_len)
+            break;
+        if (child + 1 < heap_len && HB_BEFORE(nodes[heap[child + 1]].deadline, nodes[heap[child]].deadline))
+            child++;
+        if (!HB_BEFORE(nodes[heap[child]].deadline, nodes[node_id].deadline))
+            break;
+        heap_set(pos, heap[child]);
+        pos = child;
+    }
+    heap_set(pos, node_id);
+}
+
+static void heap_remove(uint8_t node_id)
+{
+    uint8_t pos = nodes[node_id].pos;
+
+    nodes[node_id].pos = HB_NO_POS;
+    if (--heap_len > pos) {
+        uint8_t last = heap[heap_len];
+        heap_set(pos, last);
+        heap_down(pos);
+        heap_up(nodes[last].pos);
+    }
+}
+
+/* Track a state change in the bitmaps, kernel locked */
+static void hb_set_state(uint8_t node_id, uint8_t state)
+{
+    uint8_t old = nodes[node_id].state;
+    uint32_t bit = 1U << (node_id % 32);
+    int w = node_id / 32;
+
+    nodes[node_id].state = state;
+    if (state == HB_STATE_LOST) {
+        alive[w] &= ~bit;
+        flags |= HB_EVT_LOST;
+    } else {
+        alive[w] |= bit;
+        flags |= (old == HB_STATE_UNKNOWN || old == HB_STATE_LOST) ? HB_EVT_ALIVE : HB_EVT_STATE;
+    }
+    if (state == CO_NMT_OPERATIONAL)
+        operational[w] |= bit;
+    else
+        operational[w] &= ~bit;
+    changed[w] |= bit;
+}
+
+/* Timeout from 0x1016 if the node has an entry, 0x2132 otherwise */
+static sysinterval_t hb_timeout(uint8_t node_id)
+{
+    for (int i = 0; i < ODL_consumerHeartbeatTime_arrayLength; i++) {
+        uint32_t entry = OD_consumerHeartbeatTime[i];
+        if (((entry >> 16) & 0x7F) == node_id)
+            return TIME_MS2I(entry & 0xFFFF);
+    }
+    return TIME_MS2I(OD_heartbeatTimeout);
+}
+
+/* Heartbeat from the CAN RX interrupt */
+static void hb_rx(void *object, const CO_CANrxMsg_t *msg)
+{
+    uint8_t node_id, state;
+    sysinterval_t timeout;
+    hb_node_t *node;
+
+    (void)object;
+
+    if (msg->RTR || msg->IDE || msg->DLC < 1 || (msg->SID & ~0x7F) != HB_COB_ID)
+        return;
+    node_id = msg->SID & 0x7F;
+    state = msg->data[0] & 0x7F;
+    if (node_id == 0 || (timeout = hb_timeout(node_id)) == 0)
+        return;
+
+    node = &nodes[node_id];
+    node->deadline = chVTGetSystemTimeX() + timeout;
+    if (node->pos == HB_NO_POS) {
+        heap_set(heap_len++, node_id);
+        heap_up(node->pos);
+        if (node->pos == 0)
+            chBSemSignalI(&hb_bsem);
+    } else {
+        /* A deadline only moves later, unless the timeout was shortened */
+        heap_down(node->pos);
+        heap_up(node->pos);
+    }
+    if (node->state != state) {
+        hb_set_state(node_id, state);
+        chBSemSignalI(&hb_bsem);
+    }
+}
+
+void hb_monitor_init(void)
+{
+    chEvtObjectInit(&hb_event);
+    for (int i = 0; i < HB_NODES; i++) {
+        nodes[i].state = HB_STATE_UNKNOWN;
+        nodes[i].pos = HB_NO_POS;
+    }
+    CO_CANrxMonitorInit(HB_MONITOR_RX_MONITOR, NULL, hb_rx);
+}
+
+uint8_t hb_monitor_state(uint8_t node_id)
+{
+    return node_id < HB_NODES ? nodes[node_id].state : HB_STATE_UNKNOWN;
+}
+
+THD_WORKING_AREA(hb_monitor_wa, 0x200);
+THD_FUNCTION(hb_monitor, arg)
+{
+    (void)arg;
+
+    while (!chThdShouldTerminateX()) {
+        uint32_t a[4], o[4];
+        eventflags_t f;
+        sysinterval_t wait = HB_MONITOR_POLL;
+        bool publish = false;
+
+        chSysLock();
+        /* Only nodes at the top of the heap can have timed out */
+        while (heap_len > 0) {
+            systime_t now = chVTGetSystemTimeX();
+            uint8_t node_id = heap[0];
+
+            if (HB_BEFORE(now, nodes[node_id].deadline)) {
+                if (nodes[node_id].deadline - now < wait)
+                    wait = nodes[node_id].deadline - now;
+                break;
+            }
+            heap_remove(node_id);
+            hb_set_state(node_id, HB_STATE_LOST);
+        }
+        for (int i = 0; i < 4; i++) {
+            if (changed[i] != 0)
+                publish = true;
+            changed[i] = 0;
+        }
+        memcpy(a, alive, sizeof(a));
+        memcpy(o, operational, sizeof(o));
+        f = flags;
+        flags = 0;
+        chSysUnlock();
+
+        if (publish) {
+            CO_LOCK_OD();
+            memcpy(OD_nodeAlive, a, sizeof(a));
+            memcpy(OD_nodeOperational, o, sizeof(o));
+            CO_UNLOCK_OD();
+            chEvtBroadcastFlags(&hb_event, f);
+        }
+
+        chBSemWaitTimeout(&hb_bsem, wait);
+    }
+
+    chThdExit(MSG_OK);
+}
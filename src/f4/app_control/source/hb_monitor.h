@@ -0,0 +1,48 @@
+#ifndef _HB_MONITOR_H_
+#define _HB_MONITOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/* CAN receive monitor slot */
+#ifndef HB_MONITOR_RX_MONITOR
+#define HB_MONITOR_RX_MONITOR   1
+#endif
+
+/* Longest sleep of the monitor thread, bounds how long stopping it takes */
+#ifndef HB_MONITOR_POLL
+#define HB_MONITOR_POLL         TIME_MS2I(100)
+#endif
+
+/* Node states besides the NMT states in the heartbeat */
+#define HB_STATE_UNKNOWN        0xFF    /* No heartbeat seen yet */
+#define HB_STATE_LOST           0xFE    /* Heartbeat timed out */
+
+/* Event flags broadcast on hb_event */
+#define HB_EVT_ALIVE            0x1U    /* A node started sending heartbeats */
+#define HB_EVT_LOST             0x2U    /* A node timed out */
+#define HB_EVT_STATE            0x4U    /* A live node changed NMT state */
+
+/*
+ * Heartbeat monitor for every node on the bus. Heartbeats are taken from
+ * the CAN receive interrupt and node deadlines kept in a min-heap, so the
+ * timeout check only looks at the earliest deadline. The live and
+ * operational node bitmaps are published in 0x2130 and 0x2131 for SDO
+ * reads. They are not mapped to a TPDO, subscribe to hb_event for changes.
+ */
+extern event_source_t hb_event;
+
+extern THD_WORKING_AREA(hb_monitor_wa, 0x200);
+extern THD_FUNCTION(hb_monitor, arg);
+
+void hb_monitor_init(void);
+uint8_t hb_monitor_state(uint8_t node_id);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
@@ -0,0 +1,478 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "log_store.h"
+#include "crc16-ccitt.h"
+
+#define TICKS_PER_MS            ((int32_t)TIME_MS2I(1))
+
+/* MBR layout */
+#define MBR_PART_TABLE          446
+#define MBR_PART_SIZE           16
+#define MBR_PART_COUNT          4
+#define MBR_SIGNATURE           510
+
+typedef union {
+    log_seg_t seg;
+    uint8_t raw[MMCSD_BLOCK_SIZE];
+} seg_block_t;
+
+typedef struct {
+    uint32_t seq;
+    uint64_t t_first;
+} index_entry_t;
+
+/* Card access, shared by the logger thread and queries */
+static MUTEX_DECL(card_mtx);
+/* One query at a time, for the read buffers */
+static MUTEX_DECL(query_mtx);
+static bool opened;
+
+/* First block of the store, segments on the card, position of the open segment and its number */
+static uint32_t first_block;
+static uint32_t nseg;
+static uint32_t pos;
+static uint32_t next_seq;
+/* Number of the segment at position 0 in the current pass over the card */
+static uint32_t seq_base;
+static uint32_t oldest;
+
+/* Summary of the open segment */
+static log_seg_t cur;
+static seg_block_t trailer;
+
+/* Log clock, ref_ms at system time ref_sys */
+static systime_t ref_sys;
+static uint64_t ref_ms;
+
+/* Entries for the segments whose number is a multiple of stride */
+static index_entry_t seg_index[LOG_STORE_INDEX];
+static unsigned int index_len;
+static uint32_t stride = 1;
+
+/* Query read buffers, also used while opening */
+static seg_block_t qtrailer;
+static can_log_block_t qblock;
+
+static uint64_t log_time(systime_t t)
+{
+    return ref_ms + (int32_t)(t - ref_sys) / TICKS_PER_MS;
+}
+
+static void log_clock_advance(void)
+{
+    uint32_t ms = chTimeI2MS(chTimeDiffX(ref_sys, chVTGetSystemTime()));
+
+    ref_sys = chTimeAddX(ref_sys, TIME_MS2I(ms));
+    ref_ms += ms;
+}
+
+/* Log time of a record, from the block header and the segment trailer */
+static uint64_t rec_time(const log_seg_t *seg, const can_log_hdr_t *hdr, const can_log_rec_t *rec)
+{
+    uint32_t cycles = (rec->time - hdr->rtcnt) & CAN_LOG_TIME_MASK;
+
+    return seg->t_first + (int32_t)(hdr->systime - seg->systime) / TICKS_PER_MS + cycles / (seg->rtcnt_freq / 1000);
+}
+
+static uint32_t seg_lba(uint32_t p)
+{
+    return first_block + p * LOG_STORE_SEG_BLOCKS;
+}
+
+static uint32_t seq_pos(uint32_t seq)
+{
+    return (seq + nseg - seq_base) % nseg;
+}
+
+static void bloom_bits(uint32_t id, unsigned int *b1, unsigned int *b2)
+{
+    *b1 = (id * 0x9E3779B1U) >> 24;
+    *b2 = (id * 0x85EBCA77U) >> 24;
+}
+
+static bool rec_match(const log_query_t *q, const can_log_rec_t *rec)
+{
+    uint32_t id = rec->id & (CAN_LOG_ID_MASK | CAN_LOG_IDE);
+
+    if (q->cob_id != LOG_STORE_ANY_COB && id != q->cob_id)
+        return false;
+    if (q->node_id != 0 && ((rec->id & CAN_LOG_IDE) || (id & 0x7F) != q->node_id))
+        return false;
+    return true;
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * First block of the store, past LOG_STORE_FIRST_BLOCK and the end of every
+ * partition in the MBR, so the store never writes into a file system the
+ * shell may mount. Returns 0 if the card can not be read or block 0 is the
+ * boot sector of a volume spanning the whole card. card_mtx held.
+ */
+static uint32_t store_start(void)
+{
+    const uint8_t *b = trailer.raw;
+    uint64_t start = LOG_STORE_FIRST_BLOCK;
+
+    if (blkRead(&SDCD1, 0, trailer.raw, 1) != HAL_SUCCESS)
+        return 0;
+    if (b[MBR_SIGNATURE] != 0x55 || b[MBR_SIGNATURE + 1] != 0xAA)
+        return start;
+    if (memcmp(&b[54], "FAT", 3) == 0 || memcmp(&b[82], "FAT32", 5) == 0 || memcmp(&b[3], "EXFAT", 5) == 0)
+        return 0;
+
+    for (int i = 0; i < MBR_PART_COUNT; i++) {
+        const uint8_t *e = &b[MBR_PART_TABLE + i * MBR_PART_SIZE];
+        uint64_t end = (uint64_t)get_le32(&e[8]) + get_le32(&e[12]);
+
+        /* Type 0 is an unused entry */
+        if (e[4] != 0 && get_le32(&e[12]) != 0 && end > start)
+            start = end;
+    }
+    start = (start + LOG_STORE_SEG_BLOCKS - 1) / LOG_STORE_SEG_BLOCKS * LOG_STORE_SEG_BLOCKS;
+
+    return start > UINT32_MAX ? 0 : start;
+}
+
+/* Read and check a segment trailer, card_mtx held */
+static bool seg_read(uint32_t p, seg_block_t *blk)
+{
+    if (blkRead(&SDCD1, seg_lba(p) + LOG_STORE_SEG_BLOCKS - 1, blk->raw, 1) != HAL_SUCCESS)
+        return false;
+    return blk->seg.magic == LOG_STORE_MAGIC && blk->seg.blocks < LOG_STORE_SEG_BLOCKS
+        && blk->seg.crc == crc16_ccitt(blk->raw, offsetof(log_seg_t, crc), 0);
+}
+
+/* Check the data blocks of a segment against its trailer, card_mtx held */
+static bool seg_check(uint32_t p, const log_seg_t *seg)
+{
+    uint16_t crc = 0;
+
+    for (uint32_t i = 0; i < seg->blocks; i++) {
+        if (blkRead(&SDCD1, seg_lba(p) + i, (uint8_t *)&qblock, 1) != HAL_SUCCESS)
+            return false;
+        crc = crc16_ccitt((const uint8_t *)&qblock, MMCSD_BLOCK_SIZE, crc);
+    }
+    return crc == seg->data_crc;
+}
+
+static void index_add(uint32_t seq, uint64_t t_first)
+{
+    if (seq % stride != 0)
+        return;
+    /* Entries of overwritten segments go first */
+    while (index_len > 0 && seg_index[0].seq < oldest) {
+        index_len--;
+        memmove(&seg_index[0], &seg_index[1], index_len * sizeof(seg_index[0]));
+    }
+    if (index_len == LOG_STORE_INDEX) {
+        unsigned int n = 0;
+
+        stride *= 2;
+        for (unsigned int i = 0; i < index_len; i++) {
+            if (seg_index[i].seq % stride == 0)
+                seg_index[n++] = seg_index[i];
+        }
+        index_len = n;
+        if (seq % stride != 0)
+            return;
+    }
+    seg_index[index_len].seq = seq;
+    seg_index[index_len].t_first = t_first;
+    index_len++;
+}
+
+/*
+ * Find the end of the store and rebuild the index, after the card is
+ * connected. Segments are written in order over the card, so the ones of
+ * the current pass are found by a binary search on their numbers. A
+ * segment cut short by a power loss has no valid trailer, and the last
+ * segment is also checked against its data CRC.
+ */
+bool log_store_open(void)
+{
+    uint32_t seq0, first, lo, hi;
+
+    chMtxLock(&query_mtx);
+    chMtxLock(&card_mtx);
+    first_block = store_start();
+    nseg = 0;
+    if (first_block != 0 && SDCD1.capacity > first_block)
+        nseg = (SDCD1.capacity - first_block) / LOG_STORE_SEG_BLOCKS;
+    if (nseg < 2) {
+        chMtxUnlock(&card_mtx);
+        chMtxUnlock(&query_mtx);
+        return false;
+    }
+    memset(&cur, 0, sizeof(cur));
+    index_len = 0;
+    stride = 1;
+    pos = 0;
+    next_seq = 0;
+    seq_base = 0;
+    oldest = 0;
+    ref_ms = 0;
+
+    /*
+     * The numbers of the pass run from seq0 at position 0. A pass that was
+     * cut short in its first segment leaves the previous one, which ends at
+     * the last position, and the numbers continue from its overwritten
+     * first segment.
+     */
+    first = nseg;
+    if (seg_read(0, &trailer)) {
+        seq0 = trailer.seg.seq;
+        first = 0;
+    } else if (seg_read(nseg - 1, &trailer)) {
+        seq0 = trailer.seg.seq - (nseg - 1);
+        first = 1;
+    }
+
+    if (first < nseg) {
+        /* Smallest position past the current pass */
+        lo = 1;
+        hi = nseg;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (seg_read(mid, &trailer) && trailer.seg.seq == seq0 + mid)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        /* Truncate to the last segment with intact data */
+        while (lo > first && !(seg_read(lo - 1, &trailer) && seg_check(lo - 1, &trailer.seg)))
+            lo--;
+
+        next_seq = seq0 + lo;
+        pos = lo % nseg;
+        seq_base = next_seq - pos;
+        oldest = seq0 + first;
+        if (lo > first)
+            ref_ms = trailer.seg.t_last + 1;
+        /*
+         * The open segment overwrites the oldest one of a full pass, or of
+         * the previous pass if that one follows on the card.
+         */
+        if (lo == nseg || (seg_read(nseg - 1, &trailer) && trailer.seg.seq == seq0 - 1)) {
+            oldest = next_seq - nseg + 1;
+            if (lo == 0)
+                ref_ms = trailer.seg.t_last + 1;
+        }
+    }
+    ref_sys = chVTGetSystemTime();
+
+    /* One trailer read per index entry */
+    while ((next_seq - oldest) / stride > LOG_STORE_INDEX)
+        stride *= 2;
+    for (uint32_t seq = (oldest + stride - 1) / stride * stride; seq < next_seq; seq += stride) {
+        if (seg_read(seq_pos(seq), &trailer) && trailer.seg.seq == seq)
+            index_add(seq, trailer.seg.t_first);
+    }
+    opened = true;
+    chMtxUnlock(&card_mtx);
+    chMtxUnlock(&query_mtx);
+
+    return true;
+}
+
+/* Write the trailer of the open segment, card_mtx held */
+static bool seg_close(void)
+{
+    if (cur.blocks == 0)
+        return true;
+
+    memset(&trailer, 0, sizeof(trailer));
+    trailer.seg = cur;
+    trailer.seg.magic = LOG_STORE_MAGIC;
+    trailer.seg.seq = next_seq;
+    trailer.seg.rtcnt_freq = LOG_STORE_RTCNT_FREQ;
+    trailer.seg.crc = crc16_ccitt(trailer.raw, offsetof(log_seg_t, crc), 0);
+    if (blkWrite(&SDCD1, seg_lba(pos) + LOG_STORE_SEG_BLOCKS - 1, trailer.raw, 1) != HAL_SUCCESS)
+        return false;
+
+    index_add(next_seq, cur.t_first);
+    next_seq++;
+    pos = (pos + 1) % nseg;
+    seq_base = next_seq - pos;
+    /* The next segment overwrites the oldest one once it wraps */
+    if (next_seq + 1 > nseg && oldest < next_seq + 1 - nseg)
+        oldest = next_seq + 1 - nseg;
+    memset(&cur, 0, sizeof(cur));
+    return true;
+}
+
+/*
+ * Append log blocks to the open segment, closing it when full. Returns the
+ * number of blocks written, which stops at the next CAN_LOG_BURST boundary
+ * of the segment, or 0 on a failed write.
+ */
+uint32_t log_store_append(const void *blocks, uint32_t n)
+{
+    const can_log_block_t *blk = blocks;
+    uint32_t room;
+
+    chMtxLock(&card_mtx);
+    /* A full segment whose trailer write failed */
+    if (opened && cur.blocks == LOG_STORE_SEG_BLOCKS - 1 && !seg_close()) {
+        chMtxUnlock(&card_mtx);
+        return 0;
+    }
+    room = LOG_STORE_SEG_BLOCKS - 1 - cur.blocks;
+    /* Segments are aligned on the card, so writes stay in one burst aligned run */
+    if (room > CAN_LOG_BURST - cur.blocks % CAN_LOG_BURST)
+        room = CAN_LOG_BURST - cur.blocks % CAN_LOG_BURST;
+    if (n > room)
+        n = room;
+    if (!opened || blkWrite(&SDCD1, seg_lba(pos) + cur.blocks, blocks, n) != HAL_SUCCESS) {
+        chMtxUnlock(&card_mtx);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        const can_log_hdr_t *hdr = &blk[i].hdr;
+
+        if (cur.blocks == 0) {
+            cur.t_first = log_time(hdr->systime);
+            cur.systime = hdr->systime;
+            cur.rtcnt_freq = LOG_STORE_RTCNT_FREQ;
+        }
+        for (unsigned int r = 1; r <= hdr->count; r++) {
+            const can_log_rec_t *rec = &blk[i].rec[r];
+            uint32_t id = rec->id & (CAN_LOG_ID_MASK | CAN_LOG_IDE);
+            unsigned int b1, b2;
+            uint64_t t;
+
+            if (!(rec->id & CAN_LOG_IDE))
+                cur.nodes[(id & 0x7F) / 32] |= 1U << ((id & 0x7F) % 32);
+            bloom_bits(id, &b1, &b2);
+            cur.cob_bloom[b1 / 32] |= 1U << (b1 % 32);
+            cur.cob_bloom[b2 / 32] |= 1U << (b2 % 32);
+            t = rec_time(&cur, hdr, rec);
+            if (t > cur.t_last)
+                cur.t_last = t;
+        }
+        cur.frames += hdr->count;
+        cur.data_crc = crc16_ccitt((const uint8_t *)&blk[i], MMCSD_BLOCK_SIZE, cur.data_crc);
+        cur.blocks++;
+    }
+    if (cur.blocks == LOG_STORE_SEG_BLOCKS - 1)
+        seg_close();
+    chMtxUnlock(&card_mtx);
+
+    return n;
+}
+
+/* Close the open segment once it is older than the segment period */
+bool log_store_sync(void)
+{
+    bool ret = true;
+
+    chMtxLock(&card_mtx);
+    log_clock_advance();
+    if (opened && cur.blocks > 0 && chTimeDiffX(cur.systime, chVTGetSystemTime()) >= LOG_STORE_SEG_PERIOD)
+        ret = seg_close();
+    chMtxUnlock(&card_mtx);
+
+    return ret;
+}
+
+bool log_store_close(void)
+{
+    bool ret = true;
+
+    chMtxLock(&card_mtx);
+    if (opened)
+        ret = seg_close();
+    opened = false;
+    chMtxUnlock(&card_mtx);
+
+    return ret;
+}
+
+/*
+ * Call cb for every frame of the closed segments in [t1, t2] that matches
+ * the node and COB-ID. Returns the number of matches, or -1 if the store
+ * is not open.
+ */
+int log_store_query(const log_query_t *q, log_query_cb_t cb, void *arg)
+{
+    uint32_t seq, last;
+    unsigned int b1 = 0, b2 = 0;
+    int count = 0;
+    bool more = true;
+
+    chMtxLock(&query_mtx);
+    chMtxLock(&card_mtx);
+    if (!opened) {
+        chMtxUnlock(&card_mtx);
+        chMtxUnlock(&query_mtx);
+        return -1;
+    }
+    /* Start at the last indexed segment that begins before t1 */
+    seq = oldest;
+    for (unsigned int i = 0; i < index_len && seg_index[i].t_first <= q->t1; i++) {
+        if (seg_index[i].seq >= oldest)
+            seq = seg_index[i].seq;
+    }
+    last = next_seq;
+    chMtxUnlock(&card_mtx);
+
+    if (q->cob_id != LOG_STORE_ANY_COB)
+        bloom_bits(q->cob_id, &b1, &b2);
+
+    for (; more && seq < last; seq++) {
+        const log_seg_t *seg = &qtrailer.seg;
+        bool ok;
+
+        chMtxLock(&card_mtx);
+        ok = seq >= oldest && seg_read(seq_pos(seq), &qtrailer) && seg->seq == seq;
+        chMtxUnlock(&card_mtx);
+        if (!ok)
+            continue;
+        if (seg->t_first > q->t2)
+            break;
+        if (seg->t_last < q->t1)
+            continue;
+        if (q->node_id != 0 && !(seg->nodes[q->node_id / 32] & (1U << (q->node_id % 32))))
+            continue;
+        if (q->cob_id != LOG_STORE_ANY_COB && (!(seg->cob_bloom[b1 / 32] & (1U << (b1 % 32)))
+                || !(seg->cob_bloom[b2 / 32] & (1U << (b2 % 32)))))
+            continue;
+
+        for (uint32_t i = 0; more && i < seg->blocks; i++) {
+            chMtxLock(&card_mtx);
+            ok = seq >= oldest && blkRead(&SDCD1, seg_lba(seq_pos(seq)) + i, (uint8_t *)&qblock, 1) == HAL_SUCCESS;
+            chMtxUnlock(&card_mtx);
+            if (!ok || qblock.hdr.magic != CAN_LOG_MAGIC)
+                break;
+            for (unsigned int r = 1; more && r <= qblock.hdr.count; r++) {
+                uint64_t t = rec_time(seg, &qblock.hdr, &qblock.rec[r]);
+
+                if (t < q->t1 || t > q->t2 || !rec_match(q, &qblock.rec[r]))
+                    continue;
+                count++;
+                more = cb(&qblock.rec[r], t, arg);
+            }
+        }
+    }
+    chMtxUnlock(&query_mtx);
+
+    return count;
+}
+
+bool log_store_info(log_store_info_t *info)
+{
+    chMtxLock(&card_mtx);
+    info->oldest = oldest;
+    info->next = next_seq;
+    info->segments = nseg;
+    info->stride = stride;
+    info->now = log_time(chVTGetSystemTime());
+    chMtxUnlock(&card_mtx);
+
+    return opened;
+}
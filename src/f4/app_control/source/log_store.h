@@ -0,0 +1,109 @@
+#ifndef _LOG_STORE_H_
+#define _LOG_STORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+#include "can_log.h"
+
+/*
+ * Lowest card block of the store, the first 4 MiB hold the MBR and the gap
+ * before the first partition of a formatted card. The store starts past
+ * the end of every partition in the MBR, and wraps around to its start at
+ * the end of the card. A card with no room left past its partitions, or
+ * formatted as a single volume without an MBR, is not used.
+ */
+#ifndef LOG_STORE_FIRST_BLOCK
+#define LOG_STORE_FIRST_BLOCK   8192
+#endif
+
+/* Blocks per segment, the last one is the segment trailer */
+#ifndef LOG_STORE_SEG_BLOCKS
+#define LOG_STORE_SEG_BLOCKS    64
+#endif
+
+#if LOG_STORE_FIRST_BLOCK % LOG_STORE_SEG_BLOCKS != 0
+#error "LOG_STORE_FIRST_BLOCK must be a multiple of LOG_STORE_SEG_BLOCKS"
+#endif
+
+#if LOG_STORE_SEG_BLOCKS % CAN_LOG_BURST != 0
+#error "LOG_STORE_SEG_BLOCKS must be a multiple of CAN_LOG_BURST"
+#endif
+
+/* Longest a segment stays open, frames can be queried once their segment is closed */
+#ifndef LOG_STORE_SEG_PERIOD
+#define LOG_STORE_SEG_PERIOD    TIME_S2I(60)
+#endif
+
+/* Sparse index entries kept in RAM */
+#ifndef LOG_STORE_INDEX
+#define LOG_STORE_INDEX         256
+#endif
+
+/* Realtime counter frequency of the frame times */
+#ifndef LOG_STORE_RTCNT_FREQ
+#define LOG_STORE_RTCNT_FREQ    STM32_SYSCLK
+#endif
+
+#define LOG_STORE_MAGIC         0x474F4C43U
+#define LOG_STORE_ANY_COB       0xFFFFFFFFU
+
+/*
+ * Segment trailer, in the last block of a segment. Times are on the log
+ * clock, in ms, which continues from the last segment across restarts.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;               /* Segment number, continued across restarts */
+    uint64_t t_first;           /* Log time of the first frame */
+    uint64_t t_last;            /* Log time of the last frame */
+    uint32_t systime;           /* System time at t_first, places the block headers */
+    uint32_t rtcnt_freq;
+    uint32_t frames;
+    uint16_t blocks;            /* Data blocks used, from the start of the segment */
+    uint16_t data_crc;          /* CRC-16-CCITT of the used data blocks */
+    uint32_t nodes[4];          /* Nodes seen, by the low 7 bits of standard COB-IDs */
+    uint32_t cob_bloom[8];      /* Bloom filter of the COB-IDs, 2 bits per ID */
+    uint16_t reserved;
+    uint16_t crc;               /* CRC-16-CCITT of the fields above */
+} log_seg_t;
+
+typedef struct {
+    uint8_t node_id;            /* 0 for any node */
+    uint32_t cob_id;            /* LOG_STORE_ANY_COB for any COB-ID */
+    uint64_t t1;
+    uint64_t t2;
+} log_query_t;
+
+typedef struct {
+    uint32_t oldest;            /* First segment still on the card */
+    uint32_t next;              /* Number of the segment being filled */
+    uint32_t segments;          /* Segments the card holds */
+    uint32_t stride;            /* Segments per index entry */
+    uint64_t now;               /* Log time */
+} log_store_info_t;
+
+/* Called per matching frame with its log time, returns false to stop the query */
+typedef bool (*log_query_cb_t)(const can_log_rec_t *rec, uint64_t t, void *arg);
+
+/*
+ * Append-only store of CAN log blocks on the SD card, in fixed size block
+ * aligned segments. Segment trailers are summarized in a sparse index in
+ * RAM, so a query only reads the trailers of segments in its time range
+ * and the data blocks of those that may hold the node or COB-ID asked for.
+ * Opening the store truncates it to the last segment with valid data.
+ */
+bool log_store_open(void);
+uint32_t log_store_append(const void *blocks, uint32_t n);
+bool log_store_sync(void);
+bool log_store_close(void);
+int log_store_query(const log_query_t *q, log_query_cb_t cb, void *arg);
+bool log_store_info(log_store_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
@@ -0,0 +1,160 @@
+#include "lss_scan.h"
+#include "hb_monitor.h"
+#include "CANopen.h"
+
+#define SCAN_POLL               TIME_MS2I(100)
+
+static MUTEX_DECL(lss_mtx);
+/* Signalled from the CAN RX interrupt on a slave answer */
+static BSEMAPHORE_DECL(lss_bsem, true);
+static systime_t prev_time;
+/* IDs handed out by this node, until their heartbeat shows up, guarded by lss_mtx */
+static uint32_t assigned[4];
+/* Arguments of the service in progress, guarded by lss_mtx */
+static CO_LSSmaster_fastscan_t fastscan;
+static uint8_t assign_id;
+
+static void lss_signal(void *object)
+{
+    (void)object;
+
+    chBSemSignalI(&lss_bsem);
+}
+
+/* Wait for an answer, returns the whole milliseconds elapsed, the rest carries over */
+static uint16_t lss_wait(void)
+{
+    uint32_t ms;
+
+    chBSemWaitTimeout(&lss_bsem, TIME_MS2I(LSS_SCAN_TIMEOUT));
+    ms = chTimeI2MS(chTimeDiffX(prev_time, chVTGetSystemTimeX()));
+    prev_time = chTimeAddX(prev_time, TIME_MS2I(ms));
+    return ms;
+}
+
+/* Run one LSS master service until the slave answers or times out */
+#define LSS_RUN(ret, call) do {                                                 \
+        uint16_t ms_ = 0;                                                       \
+        prev_time = chVTGetSystemTimeX();                                       \
+        while (((ret) = call(CO->LSSmaster, ms_)) == CO_LSSmaster_WAIT_SLAVE)   \
+            ms_ = lss_wait();                                                   \
+    } while (0)
+
+/* Lowest ID not in 0x1F81, not heard from and not handed out before */
+static uint8_t lss_free_id(void)
+{
+    for (uint8_t node_id = LSS_SCAN_FIRST_ID; node_id <= 127; node_id++) {
+        uint32_t bit = 1U << (node_id % 32);
+
+        if (hb_monitor_state(node_id) != HB_STATE_UNKNOWN) {
+            /* The heartbeat keeps it taken from now on, even once lost */
+            assigned[node_id / 32] &= ~bit;
+            continue;
+        }
+        if (node_id == OD_CANNodeID || (assigned[node_id / 32] & bit) ||
+                (OD_slaveAssignment[node_id - 1] & 0x1))
+            continue;
+        return node_id;
+    }
+    return 0;
+}
+
+static CO_LSSmaster_return_t lss_identify(CO_LSSmaster_t *lss, uint16_t ms)
+{
+    return CO_LSSmaster_IdentifyFastscan(lss, ms, &fastscan);
+}
+
+static CO_LSSmaster_return_t lss_node_id(CO_LSSmaster_t *lss, uint16_t ms)
+{
+    return CO_LSSmaster_configureNodeId(lss, ms, assign_id);
+}
+
+static CO_LSSmaster_return_t lss_bitrate(CO_LSSmaster_t *lss, uint16_t ms)
+{
+    return CO_LSSmaster_configureBitTiming(lss, ms, OD_CANBitRate);
+}
+
+static CO_LSSmaster_return_t lss_store(CO_LSSmaster_t *lss, uint16_t ms)
+{
+    return CO_LSSmaster_configureStore(lss, ms);
+}
+
+/*
+ * Find every unconfigured node and assign it a node ID. Returns the number
+ * of nodes assigned, or -1 if the scan failed part way.
+ */
+int lss_scan_run(void)
+{
+    CO_LSSmaster_return_t ret;
+    systime_t start;
+    int count = 0;
+
+    if (CO == NULL || CO->LSSmaster == NULL)
+        return -1;
+
+    chMtxLock(&lss_mtx);
+    CO_LSSmaster_initCallback(CO->LSSmaster, NULL, lss_signal);
+    CO_LSSmaster_changeTimeout(CO->LSSmaster, LSS_SCAN_TIMEOUT);
+    start = chVTGetSystemTimeX();
+
+    for (;;) {
+        for (int i = 0; i < 4; i++) {
+            fastscan.scan[i] = CO_LSSmaster_FS_SCAN;
+            fastscan.match.addr[i] = 0;
+        }
+        /* The found node is left selected for configuration */
+        LSS_RUN(ret, lss_identify);
+        if (ret != CO_LSSmaster_SCAN_FINISHED)
+            break;
+
+        assign_id = lss_free_id();
+        if (assign_id != 0) {
+            LSS_RUN(ret, lss_node_id);
+        } else {
+            ret = CO_LSSmaster_ILLEGAL_ARGUMENT;
+        }
+        if (ret == CO_LSSmaster_OK) {
+            LSS_RUN(ret, lss_bitrate);
+            /* Nodes without storage keep the ID until they reset */
+            LSS_RUN(ret, lss_store);
+            assigned[assign_id / 32] |= 1U << (assign_id % 32);
+            count++;
+            ret = CO_LSSmaster_OK;
+        }
+        CO_LSSmaster_switchStateDeselect(CO->LSSmaster);
+        if (ret != CO_LSSmaster_OK)
+            break;
+        /* Let the node take its ID before it could answer the next scan */
+        chThdSleep(TIME_MS2I(LSS_SCAN_TIMEOUT));
+    }
+
+    CO_LOCK_OD();
+    OD_LSSScan[ODA_LSSScan_nodesAssigned] = count;
+    OD_LSSScan[ODA_LSSScan_scanTime] = chTimeI2MS(chTimeDiffX(start, chVTGetSystemTimeX()));
+    CO_UNLOCK_OD();
+    CO_LSSmaster_initCallback(CO->LSSmaster, NULL, NULL);
+    chMtxUnlock(&lss_mtx);
+
+    /* No acknowledge to the first fast scan step, no unconfigured node left */
+    return ret == CO_LSSmaster_SCAN_NOACK ? count : -1;
+}
+
+THD_WORKING_AREA(lss_scan_wa, 0x200);
+THD_FUNCTION(lss_scan, arg)
+{
+    sysinterval_t waited = LSS_SCAN_PERIOD;
+
+    (void)arg;
+
+    while (!chThdShouldTerminateX()) {
+        if (waited >= LSS_SCAN_PERIOD) {
+            lss_scan_run();
+            waited = 0;
+        }
+        /* Short sleeps so stopping the worker is not held up */
+        chThdSleep(SCAN_POLL);
+        waited += SCAN_POLL;
+    }
+
+    chThdExit(MSG_OK);
+}
@@ -0,0 +1,48 @@
+#ifndef _LSS_SCAN_H_
+#define _LSS_SCAN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/*
+ * First node ID handed out. IDs below are left for cards with a fixed ID,
+ * such as control (0x01) and solar (0x04), which may be powered off
+ * through OPD while a scan runs.
+ */
+#ifndef LSS_SCAN_FIRST_ID
+#define LSS_SCAN_FIRST_ID       0x10
+#endif
+
+/*
+ * Wait for a slave answer per LSS service. Every fast scan step that no
+ * slave acknowledges costs one timeout, so this bounds the scan time.
+ */
+#ifndef LSS_SCAN_TIMEOUT
+#define LSS_SCAN_TIMEOUT        20
+#endif
+
+/* Period of the scan for newly attached nodes */
+#ifndef LSS_SCAN_PERIOD
+#define LSS_SCAN_PERIOD         TIME_S2I(5)
+#endif
+
+/*
+ * Node discovery with LSS fast scan. Unconfigured nodes are found one at a
+ * time by identity, each in about 130 frames, and given the lowest free
+ * node ID and the bitrate of this node. IDs count as taken when listed in
+ * 0x1F81, once their heartbeat has been seen, or once this node assigned
+ * them. The result of the last scan is in 0x2133.
+ */
+extern THD_WORKING_AREA(lss_scan_wa, 0x200);
+extern THD_FUNCTION(lss_scan, arg);
+
+int lss_scan_run(void);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif
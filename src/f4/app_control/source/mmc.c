@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "mmc.h"
+#include "can_log.h"
 #include "chprintf.h"
 
 #define SDC_BURST_SIZE      2
@@ -26,6 +27,12 @@ void cmd_sdc(BaseSequentialStream *chp, int argc, char *argv[]) {
         return;
     }
 
+    /* The logger writes the card from its own connection */
+    if (can_log_active()) {
+        chprintf(chp, "Card in use by the CAN logger, aborting.\r\n");
+        return;
+    }
+
     /* Card presence check.*/
     if (!blkIsInserted(&SDCD1)) {
         chprintf(chp, "Card not inserted, aborting.\r\n");
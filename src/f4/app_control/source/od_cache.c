@@ -0,0 +1,332 @@
+#include <string.h>
+
+#include "od_cache.h"
+#include "CANopen.h"
+#include "CO_master.h"
+
+#define NODE_PDOS               4
+#define PDO_MAX_MAPPED          8
+#define PDO_NONE                0xFF
+#define LEARN_TIMEOUT           500     /* ms */
+#define LEARN_POLL              TIME_MS2I(100)
+/* COB-ID, mapping count and mapped objects per TPDO */
+#define LEARN_REQS              (2 + PDO_MAX_MAPPED)
+#define HB_COB_ID               0x700
+#define NODE_BIT(id)            (1U << ((id) % 32))
+
+#if OD_CACHE_PDOS >= PDO_NONE
+#error "OD_CACHE_PDOS must be less than 255"
+#endif
+
+typedef struct {
+    uint8_t node_id;
+    uint8_t subindex;
+    uint16_t index;
+    uint8_t len;
+    bool valid;
+    uint8_t data[8];
+    systime_t stamp;
+} entry_t;
+
+typedef struct {
+    uint8_t offset;
+    uint8_t len;
+    uint16_t entry;
+} pdo_map_t;
+
+typedef struct {
+    uint16_t cob_id;            /* 0 if the slot is free */
+    uint8_t node_id;
+    uint8_t num;
+    uint8_t count;
+    pdo_map_t map[PDO_MAX_MAPPED];
+} pdo_t;
+
+/* Written by the CAN RX interrupt and under the kernel lock elsewhere */
+static entry_t entries[OD_CACHE_ENTRIES];
+static uint16_t entry_count;
+static pdo_t pdos[OD_CACHE_PDOS];
+static uint8_t cob_pdo[0x800];
+
+/* Learning is serialized, the SDO requests are too large for a stack */
+static MUTEX_DECL(learn_mtx);
+static sdo_req_t learn_reqs[NODE_PDOS][LEARN_REQS];
+static uint32_t learn_vals[NODE_PDOS][LEARN_REQS];
+/* Written by the CAN RX interrupt and under the kernel lock elsewhere */
+static uint32_t learned[4];
+static uint32_t booted[4];
+
+/*
+ * Forget what was learned about a node that sent its boot-up heartbeat.
+ * It may have come back with other TPDO parameters, or LSS gave its ID to
+ * another node. Called from the CAN RX interrupt.
+ */
+static void node_boot(uint8_t node_id)
+{
+    int w = node_id / 32;
+
+    for (int i = 0; i < OD_CACHE_PDOS; i++) {
+        if (pdos[i].cob_id != 0 && pdos[i].node_id == node_id) {
+            cob_pdo[pdos[i].cob_id] = PDO_NONE;
+            pdos[i].cob_id = 0;
+        }
+    }
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].node_id == node_id)
+            entries[i].valid = false;
+    }
+    if ((learned[w] & NODE_BIT(node_id)) || (OD_slaveAssignment[node_id - 1] & 0x1))
+        booted[w] |= NODE_BIT(node_id);
+    learned[w] &= ~NODE_BIT(node_id);
+}
+
+/* Decode a snooped TPDO, called from the CAN RX interrupt */
+static void od_cache_rx(void *object, const CO_CANrxMsg_t *msg)
+{
+    const pdo_t *pdo;
+    systime_t now;
+    uint8_t i;
+
+    (void)object;
+
+    if (msg->RTR || msg->IDE)
+        return;
+    /* Boot-up is a heartbeat in the initializing state */
+    if ((msg->SID & ~0x7F) == HB_COB_ID && (msg->SID & 0x7F) != 0 &&
+            msg->DLC >= 1 && msg->data[0] == 0) {
+        node_boot(msg->SID & 0x7F);
+        return;
+    }
+    if ((i = cob_pdo[msg->SID]) == PDO_NONE)
+        return;
+    pdo = &pdos[i];
+    now = chVTGetSystemTimeX();
+    for (i = 0; i < pdo->count; i++) {
+        const pdo_map_t *m = &pdo->map[i];
+        entry_t *e = &entries[m->entry];
+
+        if (m->offset + m->len > msg->DLC)
+            break;
+        memcpy(e->data, &msg->data[m->offset], m->len);
+        e->stamp = now;
+        e->valid = true;
+    }
+}
+
+void od_cache_init(void)
+{
+    memset(cob_pdo, PDO_NONE, sizeof(cob_pdo));
+    CO_CANrxMonitorInit(OD_CACHE_RX_MONITOR, NULL, od_cache_rx);
+}
+
+static int entry_find(uint8_t node_id, uint16_t index, uint8_t subindex)
+{
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].node_id == node_id && entries[i].index == index && entries[i].subindex == subindex)
+            return i;
+    }
+    return -1;
+}
+
+static int entry_get(uint8_t node_id, uint16_t index, uint8_t subindex, uint8_t len)
+{
+    int i = entry_find(node_id, index, subindex);
+
+    chSysLock();
+    if (i < 0 && entry_count < OD_CACHE_ENTRIES) {
+        i = entry_count;
+        entries[i].node_id = node_id;
+        entries[i].index = index;
+        entries[i].subindex = subindex;
+        entries[i].len = 0;
+        entry_count++;
+    }
+    if (i >= 0 && entries[i].len != len) {
+        entries[i].len = len;
+        entries[i].valid = false;
+    }
+    chSysUnlock();
+
+    return i;
+}
+
+/* Point the COB-ID at the new decoding of TPDO num of the node, or drop it */
+static void pdo_install(uint8_t node_id, uint8_t num, const pdo_t *pdo)
+{
+    pdo_t *slot = NULL;
+
+    chSysLock();
+    for (int i = 0; i < OD_CACHE_PDOS; i++) {
+        if (pdos[i].cob_id != 0 && pdos[i].node_id == node_id && pdos[i].num == num) {
+            cob_pdo[pdos[i].cob_id] = PDO_NONE;
+            pdos[i].cob_id = 0;
+        }
+        if (slot == NULL && pdos[i].cob_id == 0)
+            slot = &pdos[i];
+    }
+    if (pdo != NULL && slot != NULL) {
+        *slot = *pdo;
+        cob_pdo[slot->cob_id] = slot - pdos;
+    }
+    chSysUnlock();
+}
+
+/* Build the decoding of TPDO num from its learned parameters */
+static void pdo_learn(uint8_t node_id, uint8_t num, int *mapped)
+{
+    const sdo_req_t *reqs = learn_reqs[num];
+    const uint32_t *vals = learn_vals[num];
+    uint32_t cob_id = vals[0];
+    uint8_t count = vals[1] & 0xFF;
+    uint8_t offset = 0;
+    pdo_t pdo = {0};
+
+    if (reqs[0].status != CO_SDOcli_ok_communicationEnd || reqs[1].status != CO_SDOcli_ok_communicationEnd)
+        return;
+    if ((cob_id & 0x80000000) || (cob_id & 0x7FF) == 0) {
+        /* Not valid */
+        pdo_install(node_id, num, NULL);
+        return;
+    }
+
+    pdo.cob_id = cob_id & 0x7FF;
+    pdo.node_id = node_id;
+    pdo.num = num;
+    if (count > PDO_MAX_MAPPED)
+        count = PDO_MAX_MAPPED;
+    for (int i = 0; i < count; i++) {
+        uint32_t map = vals[2 + i];
+        uint16_t index = map >> 16;
+        uint8_t subindex = (map >> 8) & 0xFF;
+        uint8_t bits = map & 0xFF;
+        int e;
+
+        /* Later objects can't be placed past a bit packed one */
+        if (reqs[2 + i].status != CO_SDOcli_ok_communicationEnd || bits == 0 || bits % 8 != 0)
+            break;
+        if (offset + bits / 8 > 8)
+            break;
+        /* Dummy entries only take up space */
+        if (index >= 0x1000 && (e = entry_get(node_id, index, subindex, bits / 8)) >= 0) {
+            pdo.map[pdo.count].offset = offset;
+            pdo.map[pdo.count].len = bits / 8;
+            pdo.map[pdo.count].entry = e;
+            pdo.count++;
+        }
+        offset += bits / 8;
+    }
+    pdo_install(node_id, num, &pdo);
+    *mapped += pdo.count;
+}
+
+/*
+ * Read the TPDO parameters of a node and start decoding its TPDOs.
+ * Returns the number of mirrored objects, or -1 if the node did not answer.
+ */
+int od_cache_learn(uint8_t node_id)
+{
+    int mapped = -1;
+
+    if (node_id == 0 || node_id > 127)
+        return -1;
+
+    chMtxLock(&learn_mtx);
+    memset(learn_vals, 0, sizeof(learn_vals));
+    for (int k = 0; k < NODE_PDOS; k++) {
+        for (int i = 0; i < LEARN_REQS; i++) {
+            sdo_req_t *req = &learn_reqs[k][i];
+
+            memset(req, 0, sizeof(*req));
+            req->node_id = node_id;
+            req->index = (i == 0 ? 0x1800 : 0x1A00) + k;
+            req->subindex = (i == 0 ? 1 : i - 1);
+            req->data = &learn_vals[k][i];
+            req->len = sizeof(learn_vals[k][i]);
+            req->upload = true;
+            req->timeout = LEARN_TIMEOUT;
+        }
+    }
+    if (sdo_submit_batch(&learn_reqs[0][0], NODE_PDOS * LEARN_REQS)) {
+        for (int k = 0; k < NODE_PDOS; k++) {
+            for (int i = 0; i < LEARN_REQS; i++)
+                sdo_result(&learn_reqs[k][i]);
+        }
+        for (int k = 0; k < NODE_PDOS; k++) {
+            if (learn_reqs[k][0].status == CO_SDOcli_ok_communicationEnd && mapped < 0)
+                mapped = 0;
+            pdo_learn(node_id, k, &mapped);
+        }
+        if (mapped >= 0) {
+            chSysLock();
+            learned[node_id / 32] |= NODE_BIT(node_id);
+            chSysUnlock();
+        }
+    }
+    chMtxUnlock(&learn_mtx);
+
+    return mapped;
+}
+
+/*
+ * Copy out a mirrored value no older than max_age. Returns false if there
+ * is none, the caller then falls back to an SDO read.
+ */
+bool od_cache_get(uint8_t node_id, uint16_t index, uint8_t subindex, sysinterval_t max_age,
+        void *data, uint32_t *len, sysinterval_t *age)
+{
+    int i = entry_find(node_id, index, subindex);
+    bool fresh = false;
+
+    if (i < 0)
+        return false;
+
+    chSysLock();
+    if (entries[i].valid) {
+        *age = chTimeDiffX(entries[i].stamp, chVTGetSystemTimeX());
+        if (*age <= max_age) {
+            memcpy(data, entries[i].data, entries[i].len);
+            *len = entries[i].len;
+            fresh = true;
+        }
+    }
+    chSysUnlock();
+
+    return fresh;
+}
+
+/*
+ * Learn the nodes assigned in 0x1F81, retrying those that did not answer,
+ * and relearn nodes as soon as they boot
+ */
+THD_WORKING_AREA(od_cache_wa, 0x200);
+THD_FUNCTION(od_cache, arg)
+{
+    sysinterval_t waited = OD_CACHE_LEARN_PERIOD;
+    uint32_t boot[4];
+
+    (void)arg;
+
+    while (!chThdShouldTerminateX()) {
+        chSysLock();
+        memcpy(boot, booted, sizeof(boot));
+        memset(booted, 0, sizeof(booted));
+        chSysUnlock();
+        for (uint8_t node_id = 1; node_id <= 127 && !chThdShouldTerminateX(); node_id++) {
+            if (boot[node_id / 32] & NODE_BIT(node_id))
+                od_cache_learn(node_id);
+        }
+
+        if (waited >= OD_CACHE_LEARN_PERIOD) {
+            for (uint8_t node_id = 1; node_id <= 127 && !chThdShouldTerminateX(); node_id++) {
+                if ((OD_slaveAssignment[node_id - 1] & 0x1) && !(learned[node_id / 32] & NODE_BIT(node_id)))
+                    od_cache_learn(node_id);
+            }
+            waited = 0;
+        }
+        /* Short sleeps so stopping the worker is not held up */
+        chThdSleep(LEARN_POLL);
+        waited += LEARN_POLL;
+    }
+
+    chThdExit(MSG_OK);
+}
@@ -0,0 +1,54 @@
+#ifndef _OD_CACHE_H_
+#define _OD_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ch.h"
+#include "hal.h"
+
+/* Distinct (node, index, subindex) values mirrored */
+#ifndef OD_CACHE_ENTRIES
+#define OD_CACHE_ENTRIES        256
+#endif
+
+/* TPDOs decoded, over all nodes */
+#ifndef OD_CACHE_PDOS
+#define OD_CACHE_PDOS           64
+#endif
+
+/* Oldest cached value the shell serves instead of an SDO read */
+#ifndef OD_CACHE_MAX_AGE
+#define OD_CACHE_MAX_AGE        TIME_MS2I(1000)
+#endif
+
+/* CAN receive monitor slot */
+#ifndef OD_CACHE_RX_MONITOR
+#define OD_CACHE_RX_MONITOR     0
+#endif
+
+/* Retry period for assigned nodes whose mapping is not known yet */
+#ifndef OD_CACHE_LEARN_PERIOD
+#define OD_CACHE_LEARN_PERIOD   TIME_S2I(10)
+#endif
+
+/*
+ * Mirror of remote OD entries, fed by snooping the TPDOs of other nodes.
+ * The mapping of each node is learned by SDO reads of 0x1800-0x1803 and
+ * 0x1A00-0x1A03. Only byte aligned mappings are decoded. A boot-up
+ * heartbeat drops the node's mapping and cached values until it is
+ * learned again.
+ */
+extern THD_WORKING_AREA(od_cache_wa, 0x200);
+extern THD_FUNCTION(od_cache, arg);
+
+void od_cache_init(void);
+int od_cache_learn(uint8_t node_id);
+bool od_cache_get(uint8_t node_id, uint16_t index, uint8_t subindex, sysinterval_t max_age,
+        void *data, uint32_t *len, sysinterval_t *age);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+#endif